@@ -0,0 +1,131 @@
+#ifndef LLU_BROADCAST_H_
+#define LLU_BROADCAST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <llu/const.h>
+#include <llu/math.h>
+
+namespace llu {
+/**
+ * @brief Single-producer/multi-consumer broadcast ring buffer.
+ *
+ * Like `StaticQueue`, the producer always overwrites the oldest slot, and each item is written exactly once no matter
+ * how many readers are subscribed. Every reader keeps its own cursor and validates each slot by its sequence number,
+ * so a reader that falls behind skips to the oldest valid item and reports how many items it missed. Readers never
+ * block the writer, which requires a trivially copyable `T`. The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class BroadcastQueue {
+  static_assert(std::is_trivially_copyable<T>::value, "BroadcastQueue requires a trivially copyable type.");
+
+ public:
+  class Reader;
+
+  explicit BroadcastQueue(std::size_t capacity) : slots_(nextPow2<std::size_t>(std::max<std::size_t>(capacity, 1))) {
+    mask_ = slots_.size() - 1;
+  }
+  BroadcastQueue(const BroadcastQueue &)            = delete;
+  BroadcastQueue &operator=(const BroadcastQueue &) = delete;
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+  // Total number of items written so far
+  [[nodiscard]] std::uint64_t written() const noexcept { return written_.load(std::memory_order_acquire); }
+
+  void push_back(const T &item);
+  template <typename... Args>
+  void emplace_back(Args &&...args) {
+    push_back(T(std::forward<Args>(args)...));
+  }
+
+  // Creates a reader that receives the items written after this call
+  [[nodiscard]] Reader subscribe() const { return Reader(this, written()); }
+
+ private:
+  struct Slot {
+    // 2 * (index + 1) once item `index` is stored, odd while it is being written
+    std::atomic<std::uint64_t> seq{0};
+    T value;
+  };
+
+  std::vector<Slot> slots_;
+  std::size_t mask_{};
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> written_{0};
+};
+
+template <typename T>
+class BroadcastQueue<T>::Reader {
+ public:
+  /**
+   * @brief Reads the next item without blocking the writer.
+   *
+   * @return false if no new item is available.
+   */
+  bool try_pop(T &item);
+
+  [[nodiscard]] std::size_t available() const noexcept { return queue_->written() - cursor_; }
+  // Number of items overwritten before this reader could consume them
+  [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_; }
+  // Skips all pending items
+  void seek_latest() noexcept { cursor_ = queue_->written(); }
+
+ private:
+  friend class BroadcastQueue;
+  Reader(const BroadcastQueue *queue, std::uint64_t cursor) : queue_(queue), cursor_(cursor) {}
+  void skip_overrun();
+
+  const BroadcastQueue *queue_;
+  std::uint64_t cursor_;
+  std::uint64_t dropped_{0};
+};
+
+template <typename T>
+void BroadcastQueue<T>::push_back(const T &item) {
+  std::uint64_t index = written_.load(std::memory_order_relaxed);
+  Slot &slot          = slots_[index & mask_];
+  slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.value = item;
+  slot.seq.store(2 * index + 2, std::memory_order_release);
+  written_.store(index + 1, std::memory_order_release);
+}
+
+template <typename T>
+bool BroadcastQueue<T>::Reader::try_pop(T &item) {
+  while (true) {
+    const Slot &slot       = queue_->slots_[cursor_ & queue_->mask_];
+    std::uint64_t expected = 2 * cursor_ + 2;
+    std::uint64_t seq      = slot.seq.load(std::memory_order_acquire);
+    if (seq < expected) return false;  // not written yet or being written
+    if (seq > expected) {
+      skip_overrun();
+      continue;
+    }
+    item = slot.value;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq) {
+      skip_overrun();
+      continue;
+    }
+    ++cursor_;
+    return true;
+  }
+}
+
+template <typename T>
+void BroadcastQueue<T>::Reader::skip_overrun() {
+  // Leave one slot of margin since the writer may already be overwriting the oldest one
+  std::uint64_t written = queue_->written();
+  std::uint64_t oldest  = written >= queue_->capacity() ? written - queue_->capacity() + 1 : 0;
+  if (oldest > cursor_) {
+    dropped_ += oldest - cursor_;
+    cursor_ = oldest;
+  }
+}
+}  // namespace llu
+
+#endif  // LLU_BROADCAST_H_
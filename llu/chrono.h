@@ -1,15 +1,30 @@
 #ifndef LLU_CHRONO_H_
 #define LLU_CHRONO_H_
 
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <thread>
+#include <type_traits>
 
 #include <fmt/core.h>
 
+#include <llu/histogram.h>
 #include <llu/math.h>
 
 namespace llu {
-using Clock     = std::chrono::high_resolution_clock;
+using Clock     = std::chrono::steady_clock;
 using TimePoint = Clock::time_point;
 using Duration  = Clock::duration;
 
@@ -18,36 +33,320 @@ using USec = std::chrono::microseconds;
 using NSec = std::chrono::nanoseconds;
 using std::chrono::duration_cast;
 
-template <typename Unit>
-typename Unit::rep timePassed(const TimePoint &start) {
-  return duration_cast<Unit>(Clock::now() - start).count();
+template <typename Unit, typename ClockT, typename Dur>
+typename Unit::rep timePassed(const std::chrono::time_point<ClockT, Dur> &start) {
+  return duration_cast<Unit>(ClockT::now() - start).count();
 }
 
-class Rate {
- public:
-  explicit Rate(std::size_t freq) : cycle_(static_cast<std::size_t>(1e9) / freq), event_time_(Clock::now()) {}
+namespace impl {
+// Hint to the CPU that the caller is busy-waiting
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+}  // namespace impl
 
-  void sleep() {
-    event_time_ += cycle_;
-    while (Clock::now() < event_time_ - USec(50)) {
-      std::this_thread::sleep_for(USec(50));
-    }
-    while (Clock::now() < event_time_);
+/**
+ * @brief Clock reading the invariant time-stamp counter, calibrated against `CLOCK_MONOTONIC`.
+ *
+ * A reading takes a few nanoseconds instead of the 20-30 ns of a vDSO `clock_gettime`. The counter is used on x86 with
+ * an invariant TSC and on AArch64 with the generic timer. Elsewhere, or if calibration fails, `now()` falls back to
+ * `Clock`. Calibration busy-waits 10 ms on the first use, so call `usable()` at startup to keep it out of the hot path.
+ *
+ * Calibration happens once, while CLOCK_MONOTONIC keeps being slewed by NTP, so the two clocks drift apart by up to the
+ * slew rate of 500 ppm. Only compare `TscClock` time points with each other, never their `time_since_epoch()` with the
+ * one of `Clock`.
+ */
+struct TscClock {
+  using rep        = std::int64_t;
+  using period     = std::nano;
+  using duration   = NSec;
+  using time_point = std::chrono::time_point<TscClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept;
+  static bool usable() noexcept { return calibration().usable; }
+
+ private:
+  struct Calibration {
+    bool usable{false};
+    std::uint64_t ticks0{};
+    std::int64_t ns0{};
+    double ns_per_tick{};
+  };
+
+  static std::uint64_t ticks() noexcept;
+  static bool invariant() noexcept;
+  static const Calibration &calibration() noexcept {
+    static const Calibration calib = calibrate();
+    return calib;
   }
+  static Calibration calibrate() noexcept;
+};
+
+inline std::uint64_t TscClock::ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  std::uint64_t value;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+#else
+  return 0;
+#endif
+}
+
+inline bool TscClock::invariant() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) return false;
+  return edx & (1U << 8);
+#elif defined(__aarch64__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+inline TscClock::Calibration TscClock::calibrate() noexcept {
+  Calibration calib;
+  if (not invariant()) return calib;
+  // Pairs a clock reading with the midpoint of the counter readings around it
+  auto sample = [](std::uint64_t &ticks0) {
+    std::uint64_t before = ticks();
+    auto ns              = duration_cast<NSec>(Clock::now().time_since_epoch()).count();
+    ticks0               = before + (ticks() - before) / 2;
+    return ns;
+  };
+  std::uint64_t start_ticks, end_ticks;
+  auto start_ns = sample(start_ticks);
+  while (duration_cast<NSec>(Clock::now().time_since_epoch()).count() - start_ns < 10000000);
+  auto end_ns = sample(end_ticks);
+  if (end_ticks <= start_ticks) return calib;
+  calib.ns_per_tick = static_cast<double>(end_ns - start_ns) / static_cast<double>(end_ticks - start_ticks);
+  calib.ticks0      = end_ticks;
+  calib.ns0         = end_ns;
+  // Counters between 1 MHz and 100 GHz are plausible
+  calib.usable      = calib.ns_per_tick > 0.01 and calib.ns_per_tick < 1000.;
+  return calib;
+}
+
+inline TscClock::time_point TscClock::now() noexcept {
+  const Calibration &calib = calibration();
+  if (not calib.usable) return time_point(duration_cast<NSec>(Clock::now().time_since_epoch()));
+  auto elapsed = static_cast<std::int64_t>(ticks() - calib.ticks0);
+  return time_point(NSec(calib.ns0 + static_cast<std::int64_t>(static_cast<double>(elapsed) * calib.ns_per_tick)));
+}
+
+/**
+ * @brief Manually advanced clock for simulation and replay, shared by all threads of the process.
+ *
+ * Time stands still until `advance()` or `set()` is called, and `BasicRate<VirtualClock>` wakes up as soon as the
+ * simulated time reaches its deadline. `sleepers()` lets a simulator step time only once all loops wait for it, which
+ * runs the loops in lockstep and as fast as they compute.
+ */
+struct VirtualClock {
+  using rep        = std::int64_t;
+  using period     = std::nano;
+  using duration   = NSec;
+  using time_point = std::chrono::time_point<VirtualClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept { return time_point(NSec(state().now.load(std::memory_order_acquire))); }
+  // Moves time forward by `step` and wakes the sleepers whose deadline is reached
+  static void advance(duration step) { set(now() + step); }
+  static void set(time_point time);
+  // Blocks until `now()` reaches `deadline`
+  static void sleepUntil(time_point deadline);
+  // Number of threads blocked in `sleepUntil()`
+  static std::size_t sleepers() noexcept { return state().sleepers.load(std::memory_order_acquire); }
 
  private:
+  struct State {
+    std::atomic<std::int64_t> now{0};
+    std::atomic<std::size_t> sleepers{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+  static State &state() noexcept {
+    static State state;
+    return state;
+  }
+};
+
+inline void VirtualClock::set(time_point time) {
+  State &st = state();
+  {
+    std::lock_guard<std::mutex> lock(st.mutex);
+    st.now.store(time.time_since_epoch().count(), std::memory_order_release);
+  }
+  st.cv.notify_all();
+}
+
+inline void VirtualClock::sleepUntil(time_point deadline) {
+  State &st = state();
+  std::unique_lock<std::mutex> lock(st.mutex);
+  if (now() >= deadline) return;
+  st.sleepers.fetch_add(1, std::memory_order_acq_rel);
+  while (now() < deadline) st.cv.wait_for(lock, MSec(100));
+  st.sleepers.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+enum class OverrunPolicy {
+  kCatchUp,  // keep the schedule, the missed cycles run back-to-back
+  kSkip,     // keep the phase, the missed cycles are skipped
+  kRephase,  // restart the schedule at the end of the overrunning cycle
+};
+
+/**
+ * @brief Sleeps until absolute, evenly spaced deadlines of `ClockT`.
+ *
+ * Each sleep blocks in `clock_nanosleep` until shortly before the deadline and busy-waits the rest, where the spin
+ * window adapts to the observed wake-up latency of the system. Deadlines of clocks other than `Clock` are mapped to
+ * CLOCK_MONOTONIC through the time left, whatever their epoch. Clocks that provide their own `sleepUntil()`, like
+ * `VirtualClock`, are waited on through it instead.
+ */
+template <typename ClockT = Clock>
+class BasicRate {
+ public:
+  using Duration  = typename ClockT::duration;
+  using TimePoint = typename ClockT::time_point;
+
+  explicit BasicRate(std::size_t freq, OverrunPolicy policy = OverrunPolicy::kCatchUp)
+      : BasicRate(NSec(static_cast<std::size_t>(1e9) / freq), policy) {}
+  explicit BasicRate(NSec cycle, OverrunPolicy policy = OverrunPolicy::kCatchUp)
+      : cycle_(cycle), event_time_(ClockT::now()), policy_(policy) {}
+
+  /**
+   * @brief Sleeps until the end of the current cycle.
+   *
+   * @return How late the cycle finished, zero if it finished before its deadline.
+   */
+  Duration sleep();
+  // Restarts the schedule from now or from `start`, the next sleep ends one cycle later
+  void reset() { event_time_ = ClockT::now(); }
+  void reset(TimePoint start) { event_time_ = start; }
+
+  [[nodiscard]] NSec cycle() const { return cycle_; }
+  [[nodiscard]] std::size_t overruns() const { return overruns_; }
+  // Wake-up lateness of the last sleep
+  [[nodiscard]] Duration jitter() const { return jitter_; }
+
+ private:
+  static constexpr Duration kMinSpin = USec(2);
+  static constexpr Duration kMaxSpin = USec(200);
+
+  void sleepUntil(TimePoint deadline);
+
   NSec cycle_;
   TimePoint event_time_;
+  OverrunPolicy policy_;
+  Duration spin_{USec(50)}, latency_{USec(25)}, jitter_{};
+  std::size_t overruns_{};
 };
 
-class Timer {
+using Rate = BasicRate<>;
+
+namespace impl {
+template <typename ClockT, typename = void>
+struct HasSleepUntil : std::false_type {};
+
+template <typename ClockT>
+struct HasSleepUntil<ClockT, std::void_t<decltype(ClockT::sleepUntil(ClockT::now()))>> : std::true_type {};
+}  // namespace impl
+
+template <typename ClockT>
+auto BasicRate<ClockT>::sleep() -> Duration {
+  event_time_ += cycle_;
+  auto now = ClockT::now();
+  if (now >= event_time_) {
+    Duration overrun = now - event_time_;
+    ++overruns_;
+    jitter_ = Duration::zero();
+    if (policy_ == OverrunPolicy::kSkip) {
+      event_time_ += overrun / cycle_ * cycle_;
+    } else if (policy_ == OverrunPolicy::kRephase) {
+      event_time_ = now;
+    }
+    return overrun;
+  }
+  sleepUntil(event_time_);
+  return Duration::zero();
+}
+
+template <typename ClockT>
+void BasicRate<ClockT>::sleepUntil(TimePoint deadline) {
+  if constexpr (impl::HasSleepUntil<ClockT>::value) {
+    ClockT::sleepUntil(deadline);
+  } else {
+    TimePoint wake_time = deadline - spin_;
+    auto remaining      = wake_time - ClockT::now();
+    if (remaining > Duration::zero()) {
+      // Only `Clock` counts from the epoch of CLOCK_MONOTONIC, other clocks are mapped to it through the time left
+      Clock::time_point mono_wake;
+      if constexpr (std::is_same_v<ClockT, Clock>) {
+        mono_wake = wake_time;
+      } else {
+        mono_wake = Clock::now() + duration_cast<Clock::duration>(remaining);
+      }
+      auto since_epoch = duration_cast<NSec>(mono_wake.time_since_epoch()).count();
+      timespec ts{static_cast<time_t>(since_epoch / 1000000000), static_cast<long>(since_epoch % 1000000000)};
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+      // Spin for about twice the average wake-up latency
+      latency_ += (ClockT::now() - wake_time - latency_) / 8;
+      spin_ = std::clamp<Duration>(2 * latency_, kMinSpin, kMaxSpin);
+    }
+    while (ClockT::now() < deadline) impl::cpuRelax();
+  }
+  jitter_ = ClockT::now() - deadline;
+}
+
+/**
+ * @brief Accumulates the durations between `start()` and `stop()`.
+ *
+ * `ClockT` selects the clock source, e.g. `TscClock` for single-digit nanosecond overhead.
+ */
+template <typename ClockT = Clock>
+class BasicTimer {
  public:
-  void start() { start_ = Clock::now(); }
+  using Duration  = typename ClockT::duration;
+  using TimePoint = typename ClockT::time_point;
+
+  void start() {
+    if (probe_) probe_hook_(probe_, true);
+    start_ = ClockT::now();
+  }
 
   void stop() {
-    stop_ = Clock::now();
+    stop_ = ClockT::now();
     count_ += 1;
     duration_ += stop_ - start_;
+    if (histogram_) histogram_->record(stop_ - start_);
+    if (probe_) probe_hook_(probe_, false);
+  }
+  // Additionally records every measured duration into `histogram`, a null histogram to detach it
+  void attach(Histogram *histogram) { histogram_ = histogram; }
+  // Additionally calls `probe->start()` and `probe->stop()` around every measurement, e.g. `PerfStats` of llu/perf.h,
+  // a null probe to detach it
+  template <typename Probe>
+  void attach(Probe *probe) {
+    probe_      = probe;
+    probe_hook_ = [](void *p, bool start) {
+      if (start) {
+        static_cast<Probe *>(p)->start();
+      } else {
+        static_cast<Probe *>(p)->stop();
+      }
+    };
+  }
+  // Detaches both the histogram and the probe
+  void attach(std::nullptr_t) {
+    histogram_ = nullptr;
+    probe_     = nullptr;
   }
 
   void clear() {
@@ -76,18 +375,25 @@ class Timer {
   TimePoint start_, stop_;
   Duration duration_{0};
   std::size_t count_ = 0;
+  Histogram *histogram_{nullptr};
+  void *probe_{nullptr};
+  void (*probe_hook_)(void *, bool){nullptr};
 };
 
+using Timer    = BasicTimer<>;
+using TscTimer = BasicTimer<TscClock>;
+
+template <typename ClockT = Clock>
 class TimerContext {
  public:
-  explicit TimerContext(Timer &timer) : timer_{timer} { timer_.start(); }
+  explicit TimerContext(BasicTimer<ClockT> &timer) : timer_{timer} { timer_.start(); }
   ~TimerContext() { timer_.stop(); }
 
  private:
-  Timer &timer_;
+  BasicTimer<ClockT> &timer_;
 };
 
-template <typename Unit = USec>
+template <typename Unit = USec, typename ClockT = Clock>
 class IntervalStats {
  public:
   explicit IntervalStats() = default;
@@ -95,19 +401,22 @@ class IntervalStats {
   void clear();
   void tick();
   std::string infoStr();
+  // Additionally records every interval into `histogram`, nullptr to detach
+  void attach(Histogram *histogram) { histogram_ = histogram; }
 
  private:
   using Rep = typename Unit::rep;
 
+  Histogram *histogram_{nullptr};
   bool first_{true};
-  TimePoint last_time_;
+  typename ClockT::time_point last_time_;
   Rep max_{}, min_{};
   double mean_{}, var_{};
   std::size_t count_{};
 };
 
-template <typename Unit>
-void IntervalStats<Unit>::clear() {
+template <typename Unit, typename ClockT>
+void IntervalStats<Unit, ClockT>::clear() {
   count_ = 0;
   mean_  = 0.;
   var_   = 0.;
@@ -115,9 +424,9 @@ void IntervalStats<Unit>::clear() {
   min_   = std::numeric_limits<Rep>::max();
 }
 
-template <typename Unit>
-void IntervalStats<Unit>::tick() {
-  auto now = Clock::now();
+template <typename Unit, typename ClockT>
+void IntervalStats<Unit, ClockT>::tick() {
+  auto now = ClockT::now();
   if (first_) {
     last_time_ = now;
     max_       = 0;
@@ -126,6 +435,7 @@ void IntervalStats<Unit>::tick() {
     return;
   }
 
+  if (histogram_) histogram_->record(now - last_time_);
   auto duration = duration_cast<Unit>(now - last_time_).count();
   last_time_    = now;
   max_          = std::max(max_, duration);
@@ -139,8 +449,8 @@ void IntervalStats<Unit>::tick() {
   count_ += 1;
 }
 
-template <typename Unit>
-std::string IntervalStats<Unit>::infoStr() {
+template <typename Unit, typename ClockT>
+std::string IntervalStats<Unit, ClockT>::infoStr() {
   return fmt::format("mean = {}, stddev = {}, max = {}, min = {}.", Unit(static_cast<Rep>(mean_)),
                      Unit(static_cast<Rep>(std::sqrt(var_ + 1e-8))), Unit(max_), Unit(min_));
 }
@@ -1,6 +1,8 @@
 #ifndef LLU_CONST_H_
 #define LLU_CONST_H_
 
+#include <cstddef>
+
 namespace llu {
 // https://en.wikipedia.org/wiki/ANSI_escape_code
 constexpr const char *kClear     = "\033[0m";
@@ -16,6 +18,8 @@ constexpr const char *kMagenta   = "\033[1;35m";
 constexpr const char *kCyan      = "\033[1;36m";
 
 constexpr double kEPS = 1e-8;
+
+constexpr std::size_t kCacheLineSize = 64;
 }  // namespace llu
 
 #endif  // LLU_CONST_H_
@@ -63,6 +63,86 @@ std::vector<Eigen::Index> getNonFiniteIndices(const Eigen::DenseBase<Derived> &d
   }
   return non_finite_indices;
 }
+
+enum class HistoryOrder { kOldestFirst, kNewestFirst };
+
+/**
+ * @brief Ring buffer of fixed-dimension frames stored as the columns of one column-major matrix.
+ *
+ * Every frame is written twice into a buffer of `2 * length` columns, so the latest `length` frames always form a
+ * contiguous block that can be mapped without copying, either oldest-first or newest-first. The first frame pushed
+ * after construction or `clear()` pads the whole history, like `StaticQueue::get_padded`.
+ */
+template <typename T>
+class HistoryMatrix {
+ public:
+  using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+  using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+  HistoryMatrix() = default;
+  HistoryMatrix(Eigen::Index dim, Eigen::Index length, HistoryOrder order = HistoryOrder::kOldestFirst)
+      : data_(dim, 2 * length), length_(length), order_(order) {}
+
+  [[nodiscard]] Eigen::Index dim() const noexcept { return data_.rows(); }
+  [[nodiscard]] Eigen::Index length() const noexcept { return length_; }
+  [[nodiscard]] Eigen::Index size() const noexcept { return size_; }
+  [[nodiscard]] bool is_empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] HistoryOrder order() const noexcept { return order_; }
+  void clear() noexcept { size_ = 0; }
+
+  template <typename Derived>
+  void push_back(const Eigen::MatrixBase<Derived> &frame);
+  template <typename Derived>
+  void fill(const Eigen::MatrixBase<Derived> &frame);
+
+  // The frames as a `dim x length` matrix, one frame per column
+  [[nodiscard]] Eigen::Map<const Matrix> matrix() const { return {window(), dim(), length_}; }
+  // The frames stacked into one vector of `dim * length`
+  [[nodiscard]] Eigen::Map<const Vector> flatten() const { return {window(), dim() * length_}; }
+  [[nodiscard]] Eigen::Map<const Vector> newest() const;
+
+ private:
+  [[nodiscard]] const T *window() const { return data_.data() + start_ * dim(); }
+
+  Matrix data_;
+  Eigen::Index length_{}, start_{}, size_{};
+  HistoryOrder order_{HistoryOrder::kOldestFirst};
+};
+
+template <typename T>
+template <typename Derived>
+void HistoryMatrix<T>::push_back(const Eigen::MatrixBase<Derived> &frame) {
+  if (size_ == 0) {
+    fill(frame);
+    size_ = 1;
+    return;
+  }
+  Eigen::Index slot;
+  if (order_ == HistoryOrder::kOldestFirst) {
+    slot   = start_;  // overwrite the oldest frame, which is then appended to the window
+    start_ = start_ + 1 == length_ ? 0 : start_ + 1;
+  } else {
+    slot   = start_ == 0 ? length_ - 1 : start_ - 1;  // the oldest frame precedes the window in the ring
+    start_ = slot;
+  }
+  data_.col(slot)           = frame;
+  data_.col(slot + length_) = frame;
+  if (size_ < length_) ++size_;
+}
+
+template <typename T>
+template <typename Derived>
+void HistoryMatrix<T>::fill(const Eigen::MatrixBase<Derived> &frame) {
+  data_.colwise() = frame;
+  start_          = 0;
+  size_           = length_;
+}
+
+template <typename T>
+auto HistoryMatrix<T>::newest() const -> Eigen::Map<const Vector> {
+  Eigen::Index offset = order_ == HistoryOrder::kOldestFirst ? length_ - 1 : 0;
+  return {window() + offset * dim(), dim()};
+}
 }  // namespace llu
 
 #endif  // LLU_EIGEN_H_
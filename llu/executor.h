@@ -0,0 +1,214 @@
+#ifndef LLU_EXECUTOR_H_
+#define LLU_EXECUTOR_H_
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <llu/chrono.h>
+#include <llu/error.h>
+#include <llu/histogram.h>
+
+namespace llu {
+// Pins the calling thread to `cpu`, returns false if the CPU does not exist or pinning is not allowed
+inline bool pinThread(int cpu) {
+  if (cpu < 0 or static_cast<unsigned>(cpu) >= std::thread::hardware_concurrency()) return false;
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+}
+
+// Switches the calling thread to `SCHED_FIFO` with `priority`, returns false without the privilege to do so
+inline bool setFifoPriority(int priority) {
+  sched_param param{};
+  param.sched_priority = priority;
+  return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+struct TaskOptions {
+  std::size_t phase{0};   // offset of the first release, in base ticks
+  std::size_t thread{0};  // index of the executing thread
+};
+
+struct ThreadOptions {
+  int cpu{-1};      // CPU to pin to, negative to not pin
+  int priority{0};  // `SCHED_FIFO` priority, 0 to keep the default policy
+};
+
+struct TaskStats {
+  std::size_t runs{}, misses{}, skipped{};  // misses include the skipped releases
+  Histogram latency;   // from the release to the start of a run
+  Histogram response;  // from the release to the end of a run
+};
+
+/**
+ * @brief Runs periodic tasks at harmonic rates on a fixed set of threads.
+ *
+ * A task of frequency `freq` is released every `base_freq / freq` base ticks, shifted by its phase. Each thread ticks a
+ * `Rate` at the greatest common divisor of the periods and phases of its tasks, so it only wakes up at ticks that may
+ * release one of them, and notices `stop()` at that tick. All threads share the same start time, so phases are
+ * deterministic across threads. Tasks of a thread run in the order they were added. A run that ends after the next
+ * release of its task is a deadline miss, and so is a release skipped because the thread overran. Statistics are
+ * written by the executing threads and are meant to be read after `stop()`.
+ */
+class Executor {
+ public:
+  explicit Executor(std::size_t base_freq, std::size_t num_threads = 1);
+  Executor(const Executor &)            = delete;
+  Executor &operator=(const Executor &) = delete;
+  ~Executor() { stop(); }
+
+  // Returns the task id
+  std::size_t addTask(std::string name, std::size_t freq, std::function<void()> func, TaskOptions options = {});
+  void setThreadOptions(std::size_t thread, ThreadOptions options);
+
+  void start();
+  void stop();
+  [[nodiscard]] bool is_running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] std::size_t numTasks() const noexcept { return tasks_.size(); }
+  [[nodiscard]] const TaskStats &stats(std::size_t task) const { return tasks_.at(task).stats; }
+  // Number of times `thread` woke up in its last run
+  [[nodiscard]] std::size_t wakeups(std::size_t thread) const { return wakeups_.at(thread); }
+  std::string infoStr() const;
+
+ private:
+  struct Task {
+    std::string name;
+    std::function<void()> func;
+    std::size_t period, phase, thread;
+    TaskStats stats;
+  };
+
+  [[nodiscard]] bool isReleased(const Task &task, std::int64_t tick) const noexcept {
+    if (tick < static_cast<std::int64_t>(task.phase)) return false;
+    return (static_cast<std::size_t>(tick) - task.phase) % task.period == 0;
+  }
+  void run(std::size_t thread, TimePoint start_time);
+
+  std::size_t base_freq_;
+  NSec cycle_;
+  std::vector<Task> tasks_;
+  std::vector<ThreadOptions> thread_options_;
+  std::vector<std::size_t> wakeups_;
+  std::vector<std::thread> threads_;
+  std::atomic<bool> running_{false};
+};
+
+inline Executor::Executor(std::size_t base_freq, std::size_t num_threads)
+    : base_freq_(base_freq),
+      cycle_(static_cast<std::size_t>(1e9) / base_freq),
+      thread_options_(num_threads),
+      wakeups_(num_threads) {
+  LLU_ASSERT(base_freq > 0 and num_threads > 0, "Invalid executor of {} Hz on {} threads.", base_freq, num_threads);
+}
+
+inline std::size_t Executor::addTask(std::string name, std::size_t freq, std::function<void()> func,
+                                     TaskOptions options) {
+  LLU_ASSERT(not is_running(), "Cannot add task '{}' to a running executor.", name);
+  LLU_ASSERT(freq > 0 and base_freq_ % freq == 0, "Rate of task '{}' ({} Hz) is not harmonic to {} Hz.", name, freq,
+             base_freq_);
+  std::size_t period = base_freq_ / freq;
+  LLU_ASSERT(options.phase < period, "Phase of task '{}' ({}) exceeds its period ({}).", name, options.phase, period);
+  LLU_ASSERT(options.thread < thread_options_.size(), "Invalid thread ({}) for task '{}'.", options.thread, name);
+  tasks_.push_back({std::move(name), std::move(func), period, options.phase, options.thread, {}});
+  return tasks_.size() - 1;
+}
+
+inline void Executor::setThreadOptions(std::size_t thread, ThreadOptions options) {
+  LLU_ASSERT(not is_running(), "Cannot configure threads of a running executor.");
+  thread_options_.at(thread) = options;
+}
+
+inline void Executor::start() {
+  LLU_ASSERT(not is_running(), "Executor is already running.");
+  for (auto &task : tasks_) task.stats = TaskStats();
+  std::fill(wakeups_.begin(), wakeups_.end(), 0);
+  running_ = true;
+  // Leave the threads some time to set up before the first release
+  TimePoint start_time = Clock::now() + MSec(1);
+  for (std::size_t i{}; i < thread_options_.size(); ++i) threads_.emplace_back(&Executor::run, this, i, start_time);
+}
+
+inline void Executor::stop() {
+  running_ = false;
+  for (auto &thread : threads_) thread.join();
+  threads_.clear();
+}
+
+inline void Executor::run(std::size_t thread, TimePoint start_time) {
+  const ThreadOptions &options = thread_options_[thread];
+  if (options.cpu >= 0 and not pinThread(options.cpu)) {
+    LLU_WARN("Failed to pin executor thread {} to CPU {}.", thread, options.cpu);
+  }
+  if (options.priority > 0 and not setFifoPriority(options.priority)) {
+    LLU_WARN("Failed to set SCHED_FIFO priority {} for executor thread {}, using the default policy.",
+             options.priority, thread);
+  }
+  std::vector<Task *> tasks;
+  // Every release falls on a multiple of the step, in base ticks
+  std::size_t step = 0;
+  for (auto &task : tasks_) {
+    if (task.thread != thread) continue;
+    tasks.push_back(&task);
+    step = std::gcd(step, std::gcd(task.period, task.phase));
+  }
+  if (tasks.empty()) return;
+
+  auto stride = static_cast<std::int64_t>(step);
+  NSec cycle  = stride * cycle_;
+  Rate rate(cycle, OverrunPolicy::kSkip);
+  rate.reset(start_time - cycle);
+  std::int64_t tick = -stride;
+  while (true) {
+    Duration overrun = rate.sleep();
+    // Nothing is released once stopping, which a thread notices at its next tick
+    if (not running_.load(std::memory_order_relaxed)) break;
+    std::int64_t next = tick + (1 + overrun / cycle) * stride;
+    wakeups_[thread] += 1;
+    // Releases within the skipped ticks are missed
+    for (std::int64_t skipped = tick + stride; skipped < next; skipped += stride) {
+      for (Task *task : tasks) {
+        bool released = isReleased(*task, skipped);
+        task->stats.misses += released;
+        task->stats.skipped += released;
+      }
+    }
+    tick              = next;
+    TimePoint release = start_time + tick * cycle_;
+    for (Task *task : tasks) {
+      if (not isReleased(*task, tick)) continue;
+      TimePoint begin = Clock::now();
+      task->func();
+      TimePoint end = Clock::now();
+      task->stats.runs += 1;
+      task->stats.latency.record(begin - release);
+      task->stats.response.record(end - release);
+      task->stats.misses += end - release > static_cast<std::int64_t>(task->period) * cycle_;
+    }
+  }
+}
+
+inline std::string Executor::infoStr() const {
+  std::string out;
+  for (const auto &task : tasks_) {
+    out += fmt::format("{} ({} Hz): runs = {}, misses = {}, latency p99 = {}, response p99 = {}.\n", task.name,
+                       base_freq_ / task.period, task.stats.runs, task.stats.misses,
+                       task.stats.latency.percentile<USec>(99.), task.stats.response.percentile<USec>(99.));
+  }
+  return out;
+}
+}  // namespace llu
+
+#endif  // LLU_EXECUTOR_H_
@@ -3,11 +3,14 @@
 
 #include <array>
 #include <cmath>
+#include <limits>
+#include <type_traits>
 
 #include <Eigen/Dense>
 
 #include <llu/eigen.h>
 #include <llu/macro.h>
+#include <llu/math.h>
 
 namespace llu {
 template <typename T>
@@ -16,46 +19,75 @@ class Quaternion {
   LLU_EIGEN_ALIAS(Vec4t, Eigen::Matrix<T, 4, 1>);
   LLU_EIGEN_ALIAS(Mat3t, Eigen::Matrix<T, 3, 3>);
   static constexpr T PI = static_cast<T>(M_PI);
+  // Bounds below which truncated series stay within half an ulp: 1 - cos(theta) for nlerp in place of slerp, theta^2
+  // for the Taylor series of `exp`, and tan^2(theta / 2) for the one of `log`. At the bounds, nlerp deviates from slerp
+  // by about 4e-8 for float and 4e-17 for double, and the first dropped terms of `exp` and `log` are about 3.8e-8 and
+  // 3.1e-8 for float, 7.3e-17 for double
+  static constexpr T kNlerpBound     = std::is_same_v<T, float> ? 1e-4 : 1e-10;
+  static constexpr T kExpSeriesBound = std::is_same_v<T, float> ? 1.2e-1 : 1.5e-4;
+  static constexpr T kLogSeriesBound = std::is_same_v<T, float> ? 6e-3 : 8e-6;
 
  public:
   LLU_ASSERT_FP(T);
-  Quaternion() : data_{1., 0., 0., 0.} {}
-  Quaternion(const Quaternion &q) : data_(q.data_) {}
+  constexpr Quaternion() : data_{1., 0., 0., 0.} {}
+  constexpr Quaternion(const Quaternion &q) = default;
+  // Constructors from coefficients normalize them
   Quaternion(T w, T x, T y, T z) : data_{w, x, y, z} { normalize(); }
   explicit Quaternion(const std::array<T, 4> &data) : data_(data) { normalize(); }
   explicit Quaternion(cVec4t q) : Quaternion{q[0], q[1], q[2], q[3]} {}
   explicit Quaternion(const Eigen::Quaternion<T> &q) : Quaternion{q.w(), q.x(), q.y(), q.z()} {}
+  // Takes the coefficients of a unit quaternion as they are, e.g. for constants or coefficients known to be normalized
+  static constexpr Quaternion unchecked(T w, T x, T y, T z) { return {UncheckedTag{}, w, x, y, z}; }
   static Quaternion fromMatrix(cMat3t mat);
-  static Quaternion fromRoll(T roll) { return {std::cos(roll / 2), std::sin(roll / 2), 0., 0.}; }
-  static Quaternion fromPitch(T pitch) { return {std::cos(pitch / 2), 0., std::sin(pitch / 2), 0.}; }
-  static Quaternion fromYaw(T yaw) { return {std::cos(yaw / 2), 0., 0., std::sin(yaw / 2)}; }
+  static Quaternion fromRoll(T roll) { return unchecked(std::cos(roll / 2), std::sin(roll / 2), 0., 0.); }
+  static Quaternion fromPitch(T pitch) { return unchecked(std::cos(pitch / 2), 0., std::sin(pitch / 2), 0.); }
+  static Quaternion fromYaw(T yaw) { return unchecked(std::cos(yaw / 2), 0., 0., std::sin(yaw / 2)); }
   static Quaternion fromEulerAngles(const Vec3t &rpy) { return fromEulerAngles(rpy.x(), rpy.y(), rpy.z()); }
   static Quaternion fromEulerAngles(const std::array<T, 3> &rpy) { return fromEulerAngles(rpy[0], rpy[1], rpy[2]); }
-  static Quaternion fromEulerAngles(T roll, T pitch, T yaw) { return fromYaw(yaw) * fromPitch(pitch) * fromRoll(roll); }
+  static Quaternion fromEulerAngles(T roll, T pitch, T yaw);
+  // Rotation of the rotation vector `vec`, i.e. the axis scaled by the angle
+  static Quaternion exp(const Vec3t &vec);
 
-  void setIdentity() { data_ = {1., 0., 0., 0.}; }
+  constexpr void setIdentity() { data_ = {1., 0., 0., 0.}; }
   [[nodiscard]] constexpr T w() const { return data_[0]; }
   [[nodiscard]] constexpr T x() const { return data_[1]; }
   [[nodiscard]] constexpr T y() const { return data_[2]; }
   [[nodiscard]] constexpr T z() const { return data_[3]; }
   [[nodiscard]] Vec4t coeffs() const { return {w(), x(), y(), z()}; }
-  [[nodiscard]] Quaternion inverse() const { return {w(), -x(), -y(), -z()}; }
+  [[nodiscard]] constexpr Quaternion inverse() const { return unchecked(w(), -x(), -y(), -z()); }
+  [[nodiscard]] Quaternion normalized() const { return Quaternion(*this).normalize(); }
   [[nodiscard]] Mat3t matrix() const;
   [[nodiscard]] Vec3t eulerAngles() const;
+  [[nodiscard]] constexpr T dot(const Quaternion &other) const;
+  [[nodiscard]] Quaternion slerp(const Quaternion &other, T factor) const;
+  // Rotation vector of the shorter of the rotations by this quaternion and its negation
+  [[nodiscard]] Vec3t log() const;
+  // Perturbation `delta` in the local frame, i.e. `*this * exp(delta)`, pulled back towards the unit sphere so that
+  // long chains of small perturbations do not drift
+  [[nodiscard]] Quaternion boxplus(const Vec3t &delta) const;
+  // Local difference to `other`, such that `other.boxplus(boxminus(other))` is this rotation
+  [[nodiscard]] Vec3t boxminus(const Quaternion &other) const { return (other.inverse() * *this).log(); }
+  // Rotation after turning at the body angular velocity `omega` for `dt`
+  [[nodiscard]] Quaternion integrate(const Vec3t &omega, T dt) const { return boxplus(omega * dt); }
 
-  [[nodiscard]] Quaternion operator*(const Quaternion &other) const;
+  // Products of unit quaternions are not normalized again, renormalize long chains of products with `normalized()`
+  [[nodiscard]] constexpr Quaternion operator*(const Quaternion &other) const;
   [[nodiscard]] Vec3t operator*(const Vec3t &vec) const;
   [[nodiscard]] bool isApprox(const Quaternion &other, T prec) const;
 
  private:
+  struct UncheckedTag {};
+
   std::array<T, 4> data_;
 
+  constexpr Quaternion(UncheckedTag, T w, T x, T y, T z) : data_{w, x, y, z} {}
+
   [[nodiscard]] T norm() const { return std::sqrt(squaredNorm()); }
   [[nodiscard]] T squaredNorm() const { return w() * w() + x() * x() + y() * y() + z() * z(); }
   Quaternion &normalize() { return operator/=(norm()); }
 
-  Quaternion operator*(T coef) const { return {w() * coef, x() * coef, y() * coef, z() * coef}; }
-  Quaternion &operator*=(T coef);
+  Quaternion operator*(T coef) const { return unchecked(w() * coef, x() * coef, y() * coef, z() * coef); }
+  constexpr Quaternion &operator*=(T coef);
   Quaternion operator/(T coef) const { return operator*(1 / coef); }
   Quaternion &operator/=(T coef) { return operator*=(1 / coef); }
 };
@@ -80,7 +112,17 @@ auto Quaternion<T>::fromMatrix(cMat3t mat) -> Quaternion {
 }
 
 template <typename T>
-auto Quaternion<T>::operator*=(T coef) -> Quaternion & {
+auto Quaternion<T>::fromEulerAngles(T roll, T pitch, T yaw) -> Quaternion {
+  // Expanded product fromYaw(yaw) * fromPitch(pitch) * fromRoll(roll)
+  T cr = std::cos(roll / 2), sr = std::sin(roll / 2);
+  T cp = std::cos(pitch / 2), sp = std::sin(pitch / 2);
+  T cy = std::cos(yaw / 2), sy = std::sin(yaw / 2);
+  return unchecked(cy * cp * cr + sy * sp * sr, cy * cp * sr - sy * sp * cr, cy * sp * cr + sy * cp * sr,
+                   sy * cp * cr - cy * sp * sr);
+}
+
+template <typename T>
+constexpr auto Quaternion<T>::operator*=(T coef) -> Quaternion & {
   data_[0] *= coef;
   data_[1] *= coef;
   data_[2] *= coef;
@@ -89,13 +131,18 @@ auto Quaternion<T>::operator*=(T coef) -> Quaternion & {
 }
 
 template <typename T>
-auto Quaternion<T>::operator*(const Quaternion &other) const -> Quaternion {
-  return {
-      w() * other.w() - x() * other.x() - y() * other.y() - z() * other.z(),
-      w() * other.x() + x() * other.w() + y() * other.z() - z() * other.y(),
-      w() * other.y() - x() * other.z() + y() * other.w() + z() * other.x(),
-      w() * other.z() + x() * other.y() - y() * other.x() + z() * other.w(),
-  };
+constexpr auto Quaternion<T>::operator*(const Quaternion &other) const -> Quaternion {
+  return unchecked(w() * other.w() - x() * other.x() - y() * other.y() - z() * other.z(),
+                   w() * other.x() + x() * other.w() + y() * other.z() - z() * other.y(),
+                   w() * other.y() - x() * other.z() + y() * other.w() + z() * other.x(),
+                   w() * other.z() + x() * other.y() - y() * other.x() + z() * other.w());
+}
+
+template <typename T>
+auto Quaternion<T>::boxplus(const Vec3t &delta) const -> Quaternion {
+  auto q = *this * exp(delta);
+  // First-order renormalization, 1 / sqrt(n) ~ (3 - n) / 2 for a squared norm n close to 1
+  return q * ((3 - q.squaredNorm()) / 2);
 }
 
 template <typename T>
@@ -105,6 +152,60 @@ bool Quaternion<T>::isApprox(const Quaternion &other, T prec) const {
   return coeffs1.isApprox(coeffs2, prec) or coeffs1.isApprox(-coeffs2, prec);
 }
 
+template <typename T>
+constexpr T Quaternion<T>::dot(const Quaternion &other) const {
+  return w() * other.w() + x() * other.x() + y() * other.y() + z() * other.z();
+}
+
+template <typename T>
+auto Quaternion<T>::slerp(const Quaternion &other, T factor) const -> Quaternion {
+  // Interpolate along the shorter arc
+  T cos_theta = dot(other);
+  T sign      = cos_theta < 0 ? -1 : 1;
+  cos_theta *= sign;
+  // Normalized linear interpolation for small angles
+  T w0 = 1 - factor, w1 = factor;
+  if (1 - cos_theta > kNlerpBound) {
+    T theta     = std::acos(cos_theta);
+    T sin_theta = std::sin(theta);
+    w0          = std::sin(w0 * theta) / sin_theta;
+    w1          = std::sin(w1 * theta) / sin_theta;
+  }
+  w1 *= sign;
+  auto q = unchecked(w0 * w() + w1 * other.w(), w0 * x() + w1 * other.x(), w0 * y() + w1 * other.y(),
+                     w0 * z() + w1 * other.z());
+  return 1 - cos_theta > kNlerpBound ? q : q.normalized();
+}
+
+template <typename T>
+auto Quaternion<T>::exp(const Vec3t &vec) -> Quaternion {
+  // cos(theta / 2) and sin(theta / 2) / theta
+  T theta2 = vec.squaredNorm();
+  T c, s;
+  if (theta2 < kExpSeriesBound) {
+    c = 1 - theta2 / 8 + theta2 * theta2 / 384;
+    s = static_cast<T>(0.5) - theta2 / 48 + theta2 * theta2 / 3840;
+  } else {
+    T theta = std::sqrt(theta2);
+    c       = std::cos(theta / 2);
+    s       = std::sin(theta / 2) / theta;
+  }
+  return unchecked(c, s * vec.x(), s * vec.y(), s * vec.z());
+}
+
+template <typename T>
+auto Quaternion<T>::log() const -> Vec3t {
+  T sign     = w() < 0 ? -1 : 1;
+  T cos_half = sign * w();
+  Vec3t u{sign * x(), sign * y(), sign * z()};
+  // theta = 2 atan(r) with r = tan(theta / 2) = |u| / w, and atan(r) / r = 1 - r^2 / 3 + r^4 / 5 - ...
+  T sin2 = u.squaredNorm();
+  T r2   = sin2 / (cos_half * cos_half);
+  if (r2 < kLogSeriesBound) return 2 / cos_half * (1 - r2 / 3 + r2 * r2 / 5) * u;
+  T sin_half = std::sqrt(sin2);
+  return 2 * std::atan2(sin_half, cos_half) / sin_half * u;
+}
+
 template <typename T>
 auto Quaternion<T>::eulerAngles() const -> Vec3t {
   return {
@@ -140,6 +241,222 @@ std::ostream &operator<<(std::ostream &os, const Quaternion<T> &q) {
   return os << "Quaternion(w=" << q.w() << ", x=" << q.x() << ", y=" << q.y() << ", z=" << q.z() << ")";
 }
 
+/**
+ * @brief Rigid transform, i.e. a rotation followed by a translation.
+ *
+ * Stored as a quaternion and a translation vector, so composition and inversion cost a quaternion product and a
+ * rotation instead of a 4 x 4 matrix product. Batches of points are transformed through the rotation matrix, which is
+ * converted once per batch.
+ */
+template <typename T>
+class Transform {
+  LLU_EIGEN_ALIAS(Vec3t, Eigen::Matrix<T, 3, 1>);
+  LLU_EIGEN_ALIAS(Mat4t, Eigen::Matrix<T, 4, 4>);
+  LLU_EIGEN_ALIAS(Mat3Xt, Eigen::Matrix<T, 3, Eigen::Dynamic>);
+
+ public:
+  LLU_ASSERT_FP(T);
+  Transform() : translation_(Vec3t::Zero()) {}
+  Transform(const Quaternion<T> &rotation, const Vec3t &translation) : rotation_(rotation), translation_(translation) {}
+  explicit Transform(const Quaternion<T> &rotation) : Transform(rotation, Vec3t::Zero()) {}
+  explicit Transform(const Vec3t &translation) : translation_(translation) {}
+
+  void setIdentity();
+  [[nodiscard]] const Quaternion<T> &rotation() const { return rotation_; }
+  [[nodiscard]] const Vec3t &translation() const { return translation_; }
+  [[nodiscard]] Mat4t matrix() const;
+  [[nodiscard]] Transform inverse() const;
+  // Pose of `other` relative to this one, i.e. `inverse() * other` without forming the inverse
+  [[nodiscard]] Transform relative(const Transform &other) const;
+
+  [[nodiscard]] Transform operator*(const Transform &other) const;
+  [[nodiscard]] Vec3t operator*(const Vec3t &point) const { return rotation_ * point + translation_; }
+  // Transforms the columns of `points`
+  template <typename Derived>
+  [[nodiscard]] Mat3Xt transformPoints(const Eigen::MatrixBase<Derived> &points) const;
+  [[nodiscard]] bool isApprox(const Transform &other, T prec) const;
+
+ private:
+  Quaternion<T> rotation_;
+  Vec3t translation_;
+};
+
+using Transformf = Transform<float>;
+using Transformd = Transform<double>;
+
+template <typename T>
+void Transform<T>::setIdentity() {
+  rotation_.setIdentity();
+  translation_.setZero();
+}
+
+template <typename T>
+auto Transform<T>::matrix() const -> Mat4t {
+  Mat4t mat                           = Mat4t::Identity();
+  mat.template topLeftCorner<3, 3>()  = rotation_.matrix();
+  mat.template topRightCorner<3, 1>() = translation_;
+  return mat;
+}
+
+template <typename T>
+auto Transform<T>::inverse() const -> Transform {
+  Quaternion<T> rotation = rotation_.inverse();
+  return {rotation, -(rotation * translation_)};
+}
+
+template <typename T>
+auto Transform<T>::relative(const Transform &other) const -> Transform {
+  Quaternion<T> rotation = rotation_.inverse();
+  return {rotation * other.rotation_, rotation * (other.translation_ - translation_)};
+}
+
+template <typename T>
+auto Transform<T>::operator*(const Transform &other) const -> Transform {
+  return {rotation_ * other.rotation_, rotation_ * other.translation_ + translation_};
+}
+
+template <typename T>
+template <typename Derived>
+auto Transform<T>::transformPoints(const Eigen::MatrixBase<Derived> &points) const -> Mat3Xt {
+  static_assert(Derived::RowsAtCompileTime == 3 or Derived::RowsAtCompileTime == Eigen::Dynamic,
+                "Points should be stored as columns of a 3 x N matrix.");
+  return (rotation_.matrix() * points).colwise() + translation_;
+}
+
+template <typename T>
+bool Transform<T>::isApprox(const Transform &other, T prec) const {
+  // Absolute comparison for translations close to zero, where a relative one fails
+  return rotation_.isApprox(other.rotation_, prec) and
+         (translation_.isApprox(other.translation_, prec) or (translation_ - other.translation_).isZero(prec));
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const Transform<T> &t) {
+  return os << "Transform(rotation=" << t.rotation() << ", translation=[" << t.translation().transpose() << "])";
+}
+
+/**
+ * @brief Kernels over batches of quaternions and vectors stored as structure of arrays.
+ *
+ * A batch of quaternions is an N x 4 array with the columns w, x, y, z, a batch of vectors an N x 3 array and a batch
+ * of rotation matrices an N x 9 array with the coefficients in row-major order. Each column is contiguous, so the
+ * kernels vectorize across the batch through Eigen array expressions. Inputs may be any Eigen array expression, e.g.
+ * a `Map` over existing buffers. Outputs are resized if they are resizable and must not alias the inputs. Quaternions
+ * are expected to be normalized.
+ */
+namespace batch {
+template <typename T>
+using QuatArray = Eigen::Array<T, Eigen::Dynamic, 4>;
+template <typename T>
+using Vec3Array = Eigen::Array<T, Eigen::Dynamic, 3>;
+template <typename T>
+using Mat3Array = Eigen::Array<T, Eigen::Dynamic, 9>;
+
+namespace impl {
+// Writable output bound to a const reference, so that temporary `Map`s and blocks can be passed
+template <typename Derived>
+Derived &output(const Eigen::ArrayBase<Derived> &out, Eigen::Index rows, Eigen::Index cols) {
+  auto &derived = const_cast<Derived &>(out.derived());
+  derived.resize(rows, cols);
+  return derived;
+}
+}  // namespace impl
+
+template <typename A, typename B, typename Out>
+void multiply(const Eigen::ArrayBase<A> &a, const Eigen::ArrayBase<B> &b, const Eigen::ArrayBase<Out> &out) {
+  auto &res = impl::output(out, a.rows(), 4);
+  auto aw = a.col(0), ax = a.col(1), ay = a.col(2), az = a.col(3);
+  auto bw = b.col(0), bx = b.col(1), by = b.col(2), bz = b.col(3);
+  res.col(0) = aw * bw - ax * bx - ay * by - az * bz;
+  res.col(1) = aw * bx + ax * bw + ay * bz - az * by;
+  res.col(2) = aw * by - ax * bz + ay * bw + az * bx;
+  res.col(3) = aw * bz + ax * by - ay * bx + az * bw;
+}
+
+template <typename Q, typename V, typename Out>
+void rotate(const Eigen::ArrayBase<Q> &q, const Eigen::ArrayBase<V> &v, const Eigen::ArrayBase<Out> &out) {
+  auto &res = impl::output(out, q.rows(), 3);
+  auto w = q.col(0), x = q.col(1), y = q.col(2), z = q.col(3);
+  auto vx = v.col(0), vy = v.col(1), vz = v.col(2);
+  // Same as the scalar rotation: 2 (u . v) u + (w^2 - u . u) v + 2 w u x v
+  auto uv = 2 * (x * vx + y * vy + z * vz);
+  auto ww = w * w - (x * x + y * y + z * z);
+  res.col(0) = uv * x + ww * vx + 2 * w * (y * vz - z * vy);
+  res.col(1) = uv * y + ww * vy + 2 * w * (z * vx - x * vz);
+  res.col(2) = uv * z + ww * vz + 2 * w * (x * vy - y * vx);
+}
+
+// Rotates by the inverse quaternions, without forming them
+template <typename Q, typename V, typename Out>
+void inverseRotate(const Eigen::ArrayBase<Q> &q, const Eigen::ArrayBase<V> &v, const Eigen::ArrayBase<Out> &out) {
+  auto &res = impl::output(out, q.rows(), 3);
+  auto w = q.col(0), x = q.col(1), y = q.col(2), z = q.col(3);
+  auto vx = v.col(0), vy = v.col(1), vz = v.col(2);
+  auto uv = 2 * (x * vx + y * vy + z * vz);
+  auto ww = w * w - (x * x + y * y + z * z);
+  res.col(0) = uv * x + ww * vx - 2 * w * (y * vz - z * vy);
+  res.col(1) = uv * y + ww * vy - 2 * w * (z * vx - x * vz);
+  res.col(2) = uv * z + ww * vz - 2 * w * (x * vy - y * vx);
+}
+
+template <typename Q, typename Out>
+void matrix(const Eigen::ArrayBase<Q> &q, const Eigen::ArrayBase<Out> &out) {
+  auto &res = impl::output(out, q.rows(), 9);
+  auto w = q.col(0), x = q.col(1), y = q.col(2), z = q.col(3);
+  res.col(0) = 1 - 2 * (y * y + z * z);
+  res.col(1) = 2 * (x * y - w * z);
+  res.col(2) = 2 * (x * z + w * y);
+  res.col(3) = 2 * (x * y + w * z);
+  res.col(4) = 1 - 2 * (x * x + z * z);
+  res.col(5) = 2 * (y * z - w * x);
+  res.col(6) = 2 * (x * z - w * y);
+  res.col(7) = 2 * (y * z + w * x);
+  res.col(8) = 1 - 2 * (x * x + y * y);
+}
+
+// Roll, pitch and yaw as the columns of `out`
+template <typename Q, typename Out>
+void eulerAngles(const Eigen::ArrayBase<Q> &q, const Eigen::ArrayBase<Out> &out) {
+  using T   = typename Q::Scalar;
+  auto &res = impl::output(out, q.rows(), 3);
+  auto w = q.col(0), x = q.col(1), y = q.col(2), z = q.col(3);
+  auto atan2 = [](T a, T b) { return std::atan2(a, b); };
+  res.col(0) = (2 * (w * x + y * z)).binaryExpr(1 - 2 * (x * x + y * y), atan2);
+  res.col(1) = (2 * (w * y - x * z)).max(T(-1)).min(T(1)).asin();
+  res.col(2) = (2 * (w * z + x * y)).binaryExpr(1 - 2 * (y * y + z * z), atan2);
+}
+
+// `eulerAngles` with the error of `approxAtan2` and `approxAsin`, but vectorized
+template <typename Q, typename Out>
+void approxEulerAngles(const Eigen::ArrayBase<Q> &q, const Eigen::ArrayBase<Out> &out) {
+  auto &res = impl::output(out, q.rows(), 3);
+  auto w = q.col(0), x = q.col(1), y = q.col(2), z = q.col(3);
+  res.col(0) = approxAtan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y));
+  res.col(1) = approxAsin(2 * (w * y - x * z));
+  res.col(2) = approxAtan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z));
+}
+
+// Roll, pitch and yaw of rotation matrices as the columns of `out`
+template <typename M, typename Out>
+void mat2rpy(const Eigen::ArrayBase<M> &mat, const Eigen::ArrayBase<Out> &out) {
+  using T    = typename M::Scalar;
+  auto &res  = impl::output(out, mat.rows(), 3);
+  auto atan2 = [](T a, T b) { return std::atan2(a, b); };
+  res.col(0) = mat.col(7).binaryExpr(mat.col(8), atan2);
+  res.col(1) = (-mat.col(6)).max(T(-1)).min(T(1)).asin();
+  res.col(2) = mat.col(3).binaryExpr(mat.col(0), atan2);
+}
+
+// `mat2rpy` with the error of `approxAtan2` and `approxAsin`, but vectorized
+template <typename M, typename Out>
+void approxMat2rpy(const Eigen::ArrayBase<M> &mat, const Eigen::ArrayBase<Out> &out) {
+  auto &res  = impl::output(out, mat.rows(), 3);
+  res.col(0) = approxAtan2(mat.col(7), mat.col(8));
+  res.col(1) = approxAsin(-mat.col(6));
+  res.col(2) = approxAtan2(mat.col(3), mat.col(0));
+}
+}  // namespace batch
+
 inline auto rpy2rot(float roll, float pitch, float yaw) {
   return Eigen::AngleAxisf(yaw, Vec3f::UnitZ()) * Eigen::AngleAxisf(pitch, Vec3f::UnitY()) *
          Eigen::AngleAxisf(roll, Vec3f::UnitX());
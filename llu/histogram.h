@@ -0,0 +1,133 @@
+#ifndef LLU_HISTOGRAM_H_
+#define LLU_HISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <fmt/chrono.h>
+#include <fmt/core.h>
+
+namespace llu {
+/**
+ * @brief Fixed-memory histogram of non-negative integer values with log-linear buckets, in the spirit of HdrHistogram.
+ *
+ * Values below 128 have exact buckets, and every further power of two is split into 64 linear sub-buckets, so a
+ * reported value is within 1/64 (~1.6%) of the recorded one. Values from 2^40 on (about 18 minutes in nanoseconds)
+ * fall into the last bucket. Recording is a few integer operations on a 18 KB array and never allocates. Durations
+ * are recorded in nanoseconds.
+ *
+ * A histogram is not thread-safe: record into one histogram per thread and `merge()` them for reporting, or hand the
+ * histogram over with `swap()` and `reset()` at the end of each reporting period.
+ */
+class Histogram {
+ public:
+  static constexpr unsigned kSubBits       = 7;
+  static constexpr unsigned kMaxBits       = 40;
+  static constexpr std::size_t kSubCount   = std::size_t{1} << kSubBits;
+  static constexpr std::size_t kNumBuckets = (kMaxBits - kSubBits) * (kSubCount / 2) + kSubCount;
+  static constexpr std::uint64_t kMaxValue = (std::uint64_t{1} << kMaxBits) - 1;
+
+  void record(std::uint64_t value) noexcept { record(value, 1); }
+  void record(std::uint64_t value, std::uint64_t num) noexcept;
+  template <typename Rep, typename Period>
+  void record(std::chrono::duration<Rep, Period> duration) noexcept {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    record(ns > 0 ? static_cast<std::uint64_t>(ns) : 0);
+  }
+
+  void merge(const Histogram &other) noexcept;
+  void reset() noexcept;
+  void swap(Histogram &other) noexcept;
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+  [[nodiscard]] std::uint64_t min() const noexcept { return count_ == 0 ? 0 : min_; }
+  [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+  [[nodiscard]] double mean() const noexcept { return count_ == 0 ? 0. : static_cast<double>(sum_) / count_; }
+  // Value that `percent` percent of the recorded values are not larger than, up to the bucket precision
+  [[nodiscard]] std::uint64_t percentile(double percent) const noexcept;
+  template <typename Unit>
+  [[nodiscard]] Unit percentile(double percent) const {
+    return std::chrono::duration_cast<Unit>(std::chrono::nanoseconds(percentile(percent)));
+  }
+  // Summary of durations recorded in nanoseconds, in `Unit`
+  template <typename Unit = std::chrono::microseconds>
+  std::string infoStr() const;
+
+  static std::size_t bucketIndex(std::uint64_t value) noexcept;
+  static std::uint64_t bucketLowest(std::size_t index) noexcept;
+  static std::uint64_t bucketHighest(std::size_t index) noexcept {
+    return index + 1 == kNumBuckets ? std::numeric_limits<std::uint64_t>::max() : bucketLowest(index + 1) - 1;
+  }
+
+ private:
+  std::array<std::uint64_t, kNumBuckets> counts_{};
+  std::uint64_t count_{}, sum_{}, max_{};
+  std::uint64_t min_{std::numeric_limits<std::uint64_t>::max()};
+};
+
+inline std::size_t Histogram::bucketIndex(std::uint64_t value) noexcept {
+  if (value < kSubCount) return value;
+  value          = std::min(value, kMaxValue);
+  unsigned shift = 63 - __builtin_clzll(value) - kSubBits + 1;
+  return shift * (kSubCount / 2) + (value >> shift);
+}
+
+inline std::uint64_t Histogram::bucketLowest(std::size_t index) noexcept {
+  if (index < kSubCount) return index;
+  std::size_t shift = index / (kSubCount / 2) - 1;
+  return static_cast<std::uint64_t>(index - shift * (kSubCount / 2)) << shift;
+}
+
+inline void Histogram::record(std::uint64_t value, std::uint64_t num) noexcept {
+  counts_[bucketIndex(value)] += num;
+  count_ += num;
+  sum_ += value * num;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+}
+
+inline void Histogram::merge(const Histogram &other) noexcept {
+  for (std::size_t i{}; i < kNumBuckets; ++i) counts_[i] += other.counts_[i];
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+inline void Histogram::reset() noexcept { *this = Histogram(); }
+
+inline void Histogram::swap(Histogram &other) noexcept {
+  std::swap(counts_, other.counts_);
+  std::swap(count_, other.count_);
+  std::swap(sum_, other.sum_);
+  std::swap(min_, other.min_);
+  std::swap(max_, other.max_);
+}
+
+inline std::uint64_t Histogram::percentile(double percent) const noexcept {
+  if (count_ == 0) return 0;
+  auto target = static_cast<std::uint64_t>(std::ceil(std::clamp(percent, 0., 100.) / 100. * count_));
+  if (target == 0) return min();
+  std::uint64_t accumulated = 0;
+  for (std::size_t i{}; i < kNumBuckets; ++i) {
+    accumulated += counts_[i];
+    if (accumulated >= target) return std::clamp(bucketHighest(i), min_, max_);
+  }
+  return max_;
+}
+
+template <typename Unit>
+std::string Histogram::infoStr() const {
+  auto cast = [](std::uint64_t ns) { return std::chrono::duration_cast<Unit>(std::chrono::nanoseconds(ns)); };
+  return fmt::format("count = {}, mean = {}, p50 = {}, p90 = {}, p99 = {}, p99.9 = {}, max = {}.", count_,
+                     cast(static_cast<std::uint64_t>(mean())), cast(percentile(50.)), cast(percentile(90.)),
+                     cast(percentile(99.)), cast(percentile(99.9)), cast(max_));
+}
+}  // namespace llu
+
+#endif  // LLU_HISTOGRAM_H_
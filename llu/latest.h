@@ -0,0 +1,115 @@
+#ifndef LLU_LATEST_H_
+#define LLU_LATEST_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <llu/const.h>
+
+namespace llu {
+/**
+ * @brief Wait-free single-writer/single-reader exchange of the newest value.
+ *
+ * The writer fills a private back buffer and publishes it by swapping it with the shared middle buffer, and the reader
+ * swaps the middle buffer with its front buffer only when a newer value was published. Neither side ever waits and
+ * any copyable `T`, including dynamically sized Eigen types, can be exchanged.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() = default;
+  explicit TripleBuffer(const T &value) : buffers_{value, value, value} {}
+  TripleBuffer(const TripleBuffer &)            = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  // Writer side, fill `back()` in place then `publish()` it, or `write()` a value directly
+  [[nodiscard]] T &back() noexcept { return buffers_[back_]; }
+  void publish() noexcept { back_ = middle_.exchange(back_ | kDirty, std::memory_order_acq_rel) & kIndexMask; }
+  void write(const T &value) {
+    back() = value;
+    publish();
+  }
+
+  // Reader side, the returned reference stays valid until the next call to `read()`
+  const T &read() noexcept {
+    update();
+    return buffers_[front_];
+  }
+  // Returns true if a value newer than the last read one was published
+  bool update() noexcept {
+    if ((middle_.load(std::memory_order_relaxed) & kDirty) == 0) return false;
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+    return true;
+  }
+
+ private:
+  static constexpr std::uint8_t kDirty     = 0x4;
+  static constexpr std::uint8_t kIndexMask = 0x3;
+
+  T buffers_[3]{};
+  alignas(kCacheLineSize) std::atomic<std::uint8_t> middle_{1};
+  alignas(kCacheLineSize) std::uint8_t back_{0};
+  alignas(kCacheLineSize) std::uint8_t front_{2};
+};
+
+/**
+ * @brief Seqlock holding the newest value, with one writer and any number of readers.
+ *
+ * The writer never blocks, and readers retry until they copy a snapshot that was not modified meanwhile. Because a
+ * reader may copy a value that is being overwritten and discard it, values are copied bytewise and `T` must hold its
+ * whole state inline: trivially copyable types, fixed-size Eigen types and aggregates of them, e.g. a pose made of a
+ * `Quatf` and a `Vec3f`. Types owning memory, like dynamically sized Eigen types, are rejected through their
+ * non-trivial destructor, use `TripleBuffer` for them.
+ */
+template <typename T>
+class LatestValue {
+  static_assert(std::is_trivially_destructible<T>::value and std::is_default_constructible<T>::value,
+                "LatestValue requires a default constructible type that holds its state inline.");
+
+ public:
+  LatestValue() = default;
+  explicit LatestValue(const T &value) : value_(value) {}
+  LatestValue(const LatestValue &)            = delete;
+  LatestValue &operator=(const LatestValue &) = delete;
+
+  void store(const T &value) noexcept;
+  [[nodiscard]] T load() const noexcept;
+  // Single attempt, returns false if the writer was busy
+  bool try_load(T &value) const noexcept;
+  // Number of values stored so far
+  [[nodiscard]] std::uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> seq_{0};
+  T value_{};
+};
+
+template <typename T>
+void LatestValue<T>::store(const T &value) noexcept {
+  std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+  seq_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(static_cast<void *>(&value_), &value, sizeof(T));
+  seq_.store(seq + 2, std::memory_order_release);
+}
+
+template <typename T>
+T LatestValue<T>::load() const noexcept {
+  T value;
+  while (not try_load(value));
+  return value;
+}
+
+template <typename T>
+bool LatestValue<T>::try_load(T &value) const noexcept {
+  std::uint64_t seq = seq_.load(std::memory_order_acquire);
+  if (seq & 1) return false;
+  std::memcpy(static_cast<void *>(&value), &value_, sizeof(T));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return seq_.load(std::memory_order_relaxed) == seq;
+}
+}  // namespace llu
+
+#endif  // LLU_LATEST_H_
@@ -8,6 +8,9 @@
 #define LLU_TO_STR_IMPL(...) #__VA_ARGS__
 #define LLU_TO_STR(text)     LLU_TO_STR_IMPL(text)
 
+#define LLU_CONCAT_IMPL(a, b) a##b
+#define LLU_CONCAT(a, b)      LLU_CONCAT_IMPL(a, b)
+
 #define LLU_FILELINE() "[" __FILE_NAME__ ":" LLU_TO_STR(__LINE__) "]"
 
 #include <type_traits>
@@ -1,7 +1,9 @@
 #ifndef LLU_MATH_H_
 #define LLU_MATH_H_
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <llu/const.h>
 #include <llu/eigen.h>
@@ -58,6 +60,15 @@ constexpr T lerp(T start, T end, T factor) {
   return start + (end - start) * factor;
 }
 
+template <typename Derived>
+typename Derived::PlainObject lerp(const Eigen::DenseBase<Derived> &start, const Eigen::DenseBase<Derived> &end,
+                                   typename Derived::Scalar factor) {
+  using T = typename Derived::Scalar;
+  LLU_ASSERT_FP(T);
+  factor = clamp<T>(factor, static_cast<T>(0), static_cast<T>(1));
+  return start.derived() + (end.derived() - start.derived()) * factor;
+}
+
 template <typename T>
 constexpr T ceilDiv(T x, T y) {
   LLU_ASSERT_INT(T);
@@ -70,6 +81,14 @@ constexpr T pMod(T dividend, T divisor) {  // positive mod, divisor must be posi
   return (dividend % divisor + divisor) % divisor;
 }
 
+template <typename T>
+constexpr T nextPow2(T x) {  // smallest power of two not less than x
+  LLU_ASSERT_INT(T);
+  T result = 1;
+  while (result < x) result <<= 1;
+  return result;
+}
+
 template <typename T>
 constexpr T angleDiff(T a1, T a2) {
   LLU_ASSERT_FP(T);
@@ -87,6 +106,132 @@ constexpr T angleDiff(T a1, T a2) {
 
 inline ArrXf sigmoid(cArrXf val) { return 1 / (1 + (-val).exp()); }
 inline ArrXd sigmoid(cArrXd val) { return 1 / (1 + (-val).exp()); }
+
+/**
+ * @brief Branchless element-wise kernels on Eigen arrays.
+ *
+ * Each kernel is a scalar function of arithmetic only, without comparisons: choices are blends with weights of 0 or
+ * 1, and rounding adds and subtracts a power of two instead of calling libm. Eigen 3.4 has no packet comparisons or
+ * selects, and compilers do not turn floating-point comparisons into blends without `-fno-trapping-math`, so this is
+ * what lets the loops over the arrays vectorize. `-ffast-math` folds that rounding away, so translation units compiled
+ * with it round through `std::nearbyint` instead, which may not vectorize. Its reassociation also breaks the exact
+ * argument reduction of sine and cosine, for `float` the error grows to about 5e-6 at |x| = 100.
+ *
+ * The `approx` functions are polynomial approximations in place of libm calls, using the polynomials of the Cephes
+ * single precision routines. Their maximum absolute error is 1e-8 for `double`, for `float` it is 1e-7 for sine and
+ * cosine and 3e-7, about 2 ulps at pi, for the inverse functions. Use the libm functions where more precision is
+ * needed.
+ */
+namespace batch {
+namespace impl {
+// Rounds to the nearest integer, ties to even, for |x| < 2^22 (float) or 2^51 (double). The magic number trick relies
+// on strict IEEE evaluation, which `-ffast-math` gives up to fold it to `x`.
+template <typename T>
+inline T round(T x) {
+#ifdef __FAST_MATH__
+  return std::nearbyint(x);
+#else
+  constexpr T kMagic = static_cast<T>(1.5) * static_cast<T>(1ULL << (std::numeric_limits<T>::digits - 1));
+  return (x + kMagic) - kMagic;
+#endif
+}
+
+// 1 if `k` is odd, 0 if even
+template <typename T>
+inline T isOdd(T k) {
+  return std::abs(k - 2 * round(k / 2));
+}
+
+template <typename T>
+inline T wrapToPi(T angle) {
+  constexpr T pi = static_cast<T>(M_PI);
+  return angle - 2 * pi * round(angle * (1 / (2 * pi)));
+}
+
+// Sine of `x`, or its cosine if `cosine`, after reduction to [-pi/4, pi/4] by multiples of pi/2. The reduction is
+// exact for |x| < 1e4.
+template <typename T>
+inline T sinCos(T x, bool cosine) {
+  // pi/2 split into parts whose products with small integers are exact
+  constexpr T kPio2Hi = 1.5703125, kPio2Mid = 4.837512969970703125e-4, kPio2Lo = 7.54978995489188216e-8;
+  T k = round(x * static_cast<T>(2 / M_PI));
+  T r = ((x - k * kPio2Hi) - k * kPio2Mid) - k * kPio2Lo;
+  T z = r * r;
+  T s = r + r * z * (T(-1.6666654611e-1) + z * (T(8.3321608736e-3) + z * T(-1.9515295891e-4)));
+  T c = 1 - T(0.5) * z +
+        z * z * (T(4.166664568298827e-2) + z * (T(-1.388731625493765e-3) + z * T(2.443315711809948e-5)));
+  // With cos(x) = sin(x + pi/2) and k = 2 j + o, sin(x) = (-1)^j sin(r + o pi/2) for o in {-1, 0, 1}
+  k += cosine;
+  T o = k - 2 * round(k / 2);
+  T j = (k - o) / 2;
+  return (1 - 2 * isOdd(j)) * ((1 - std::abs(o)) * s + o * c);
+}
+
+template <typename T>
+inline T atan2(T y, T x) {
+  constexpr T pi = static_cast<T>(M_PI), kTanPi8 = static_cast<T>(0.41421356237309504880);
+  T ax = std::abs(x), ay = std::abs(y);
+  T a  = std::min(ax, ay) / std::max(std::max(ax, ay), std::numeric_limits<T>::min());
+  // atan(a) = pi/8 + atan(t) with t in [-tan(pi/8), tan(pi/8)] for a in [0, 1]
+  T t = (a - kTanPi8) / (1 + a * kTanPi8);
+  T z = t * t;
+  T p = ((T(8.05374449538e-2) * z - T(1.38776856032e-1)) * z + T(1.99777106478e-1)) * z - T(3.33329491539e-1);
+  T r = p * z * t + t + pi / 8;
+  // Unfold the octant and the quadrant, the weights are 0 or 1
+  T swapped = (1 - std::copysign(T(1), ax - ay)) / 2;
+  r         = (1 - swapped) * r + swapped * (pi / 2 - r);
+  T left    = (1 - std::copysign(T(1), x)) / 2;
+  r         = (1 - left) * r + left * (pi - r);
+  return std::copysign(r, y);
+}
+}  // namespace impl
+
+// Wraps angles to [-pi, pi]
+template <typename Derived>
+typename Derived::PlainObject wrapToPi(const Eigen::ArrayBase<Derived> &angle) {
+  using T = typename Derived::Scalar;
+  LLU_ASSERT_FP(T);
+  return angle.unaryExpr([](T a) { return impl::wrapToPi(a); });
+}
+
+// Differences `a1 - a2` wrapped to [-pi, pi]
+template <typename Derived1, typename Derived2>
+typename Derived1::PlainObject angleDiff(const Eigen::ArrayBase<Derived1> &a1, const Eigen::ArrayBase<Derived2> &a2) {
+  return wrapToPi(a1 - a2);
+}
+
+template <typename Derived>
+typename Derived::PlainObject approxSin(const Eigen::ArrayBase<Derived> &x) {
+  using T = typename Derived::Scalar;
+  LLU_ASSERT_FP(T);
+  return x.unaryExpr([](T v) { return impl::sinCos(v, false); });
+}
+
+template <typename Derived>
+typename Derived::PlainObject approxCos(const Eigen::ArrayBase<Derived> &x) {
+  using T = typename Derived::Scalar;
+  LLU_ASSERT_FP(T);
+  return x.unaryExpr([](T v) { return impl::sinCos(v, true); });
+}
+
+// Angles in [-pi, pi], with the signed zeros handled as by `std::atan2`
+template <typename DerivedY, typename DerivedX>
+typename DerivedY::PlainObject approxAtan2(const Eigen::ArrayBase<DerivedY> &y, const Eigen::ArrayBase<DerivedX> &x) {
+  using T = typename DerivedY::Scalar;
+  LLU_ASSERT_FP(T);
+  return y.binaryExpr(x, [](T a, T b) { return impl::atan2(a, b); });
+}
+
+// Input is clamped to [-1, 1]
+template <typename Derived>
+typename Derived::PlainObject approxAsin(const Eigen::ArrayBase<Derived> &x) {
+  using T = typename Derived::Scalar;
+  LLU_ASSERT_FP(T);
+  typename Derived::PlainObject clamped = x.max(T(-1)).min(T(1));
+  // Eigen's packet square root, a libm call would check errno
+  return approxAtan2(clamped, ((1 - clamped) * (1 + clamped)).sqrt());
+}
+}  // namespace batch
 }  // namespace llu
 
 #endif  // LLU_MATH_H_
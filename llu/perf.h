@@ -0,0 +1,141 @@
+#ifndef LLU_PERF_H_
+#define LLU_PERF_H_
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace llu {
+enum class PerfEvent { kCycles, kInstructions, kLlcMisses, kBranchMisses };
+
+struct PerfSample {
+  std::uint64_t cycles{}, instructions{}, llc_misses{}, branch_misses{};
+
+  [[nodiscard]] double ipc() const { return cycles == 0 ? 0. : static_cast<double>(instructions) / cycles; }
+
+  PerfSample &operator+=(const PerfSample &other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llc_misses += other.llc_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+  }
+  PerfSample operator-(const PerfSample &other) const {
+    return {cycles - other.cycles, instructions - other.instructions, llc_misses - other.llc_misses,
+            branch_misses - other.branch_misses};
+  }
+  PerfSample operator/(std::uint64_t num) const {
+    if (num == 0) return {};
+    return {cycles / num, instructions / num, llc_misses / num, branch_misses / num};
+  }
+};
+
+/**
+ * @brief Hardware performance counters of the calling thread, read as one `perf_event_open` group.
+ *
+ * Counting is limited to user space. When perf events are not permitted (see `perf_event_paranoid`) or the hardware
+ * has no PMU, e.g. in many virtual machines, `available()` is false and reads yield zeros. Events the hardware lacks
+ * are left out of the group and read as zero. A read is one syscall, so sample scopes of a few microseconds or more.
+ */
+class PerfCounters {
+ public:
+  PerfCounters();
+  PerfCounters(const PerfCounters &)            = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+  ~PerfCounters();
+
+  [[nodiscard]] bool available() const noexcept { return fds_[0] >= 0; }
+  [[nodiscard]] bool supported(PerfEvent event) const noexcept { return fds_[static_cast<int>(event)] >= 0; }
+  // Reads the current counter values, returns false and zeros if unavailable
+  bool read(PerfSample &sample) const noexcept;
+
+ private:
+  static constexpr int kNumEvents = 4;
+
+  std::array<int, kNumEvents> fds_{-1, -1, -1, -1};
+  std::array<int, kNumEvents> slots_{-1, -1, -1, -1};  // position of each event in the group read
+  int num_open_{};
+};
+
+inline PerfCounters::PerfCounters() {
+  constexpr std::array<std::uint64_t, kNumEvents> kConfigs{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                           PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  for (int i{}; i < kNumEvents; ++i) {
+    perf_event_attr attr{};
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = kConfigs[i];
+    attr.disabled       = i == 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+    auto fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, fds_[0], PERF_FLAG_FD_CLOEXEC));
+    // Without the cycle counter as group leader, nothing is counted
+    if (fd < 0 and i == 0) return;
+    if (fd < 0) continue;
+    fds_[i]   = fd;
+    slots_[i] = num_open_++;
+  }
+  ::ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+inline PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) ::close(fd);
+  }
+}
+
+inline bool PerfCounters::read(PerfSample &sample) const noexcept {
+  sample = {};
+  if (not available()) return false;
+  std::array<std::uint64_t, 1 + kNumEvents> buffer{};
+  auto size = static_cast<ssize_t>(sizeof(std::uint64_t) * (1 + num_open_));
+  if (::read(fds_[0], buffer.data(), size) != size) return false;
+  auto value = [&](PerfEvent event) {
+    int slot = slots_[static_cast<int>(event)];
+    return slot < 0 ? std::uint64_t{0} : buffer[1 + slot];
+  };
+  sample = {value(PerfEvent::kCycles), value(PerfEvent::kInstructions), value(PerfEvent::kLlcMisses),
+            value(PerfEvent::kBranchMisses)};
+  return true;
+}
+
+/**
+ * @brief Accumulates the counter deltas of `PerfCounters` over the measurements of a timer.
+ *
+ * Attach it with `BasicTimer::attach(&stats)`, the timer then samples the counters around every measurement.
+ */
+class PerfStats {
+ public:
+  explicit PerfStats(const PerfCounters &counters) : counters_(counters) {}
+
+  void start() { counters_.read(start_); }
+  void stop() {
+    PerfSample sample;
+    counters_.read(sample);
+    total_ += sample - start_;
+    count_ += 1;
+  }
+  void clear() {
+    total_ = {};
+    count_ = 0;
+  }
+
+  [[nodiscard]] std::size_t count() const { return count_; }
+  [[nodiscard]] PerfSample total() const { return total_; }
+  [[nodiscard]] PerfSample mean() const { return total_ / count_; }
+
+ private:
+  const PerfCounters &counters_;
+  PerfSample start_, total_;
+  std::size_t count_{};
+};
+}  // namespace llu
+
+#endif  // LLU_PERF_H_
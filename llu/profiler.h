@@ -0,0 +1,201 @@
+#ifndef LLU_PROFILER_H_
+#define LLU_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <llu/chrono.h>
+#include <llu/error.h>
+#include <llu/macro.h>
+
+namespace llu {
+/**
+ * @brief Registry of named scope timers, organized as a tree by their slash-separated paths.
+ *
+ * `LLU_PROFILE("control/estimator/ekf")` registers the path once per call site and times the enclosing scope with
+ * `TscClock`. Every thread accumulates into its own shard of relaxed atomics, so recording never contends, and reports
+ * sum up the shards of all threads, including exited ones. Self-time excludes the time spent in profiled scopes nested
+ * at runtime.
+ */
+class Profiler {
+ public:
+  static constexpr std::size_t kMaxNodes = 1024;
+
+  struct Stats {
+    std::uint64_t count{};
+    NSec total{}, self{};
+    [[nodiscard]] NSec mean() const { return count == 0 ? NSec{0} : total / static_cast<NSec::rep>(count); }
+  };
+
+  static Profiler &instance() {
+    static Profiler profiler;
+    return profiler;
+  }
+  Profiler(const Profiler &)            = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+  // Registers `path` and its ancestors if needed, returns the node id
+  std::size_t node(const std::string &path);
+  void record(std::size_t id, std::int64_t total_ns, std::int64_t children_ns) noexcept;
+
+  [[nodiscard]] Stats stats(const std::string &path) const;
+  // Tree of all nodes with count, total, mean and self-time
+  [[nodiscard]] std::string report() const;
+  void reset();
+
+ private:
+  static constexpr std::size_t kNoParent = SIZE_MAX;
+
+  struct Entry {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::int64_t> total{0}, children{0};
+  };
+  struct Shard {
+    std::array<Entry, kMaxNodes> entries;
+  };
+  struct Node {
+    std::string name;
+    std::size_t parent;
+    std::vector<std::size_t> children;
+  };
+
+  Profiler() = default;
+  Shard &localShard();
+  [[nodiscard]] Stats collect(std::size_t id) const;
+  void reportNode(std::string &out, std::size_t id, int depth) const;
+
+  mutable std::mutex mutex_;  // guards the nodes and the shard list
+  std::vector<Node> nodes_;
+  std::vector<std::size_t> roots_;
+  std::unordered_map<std::string, std::size_t> ids_;
+  std::vector<std::shared_ptr<Shard>> shards_;
+};
+
+// Times the enclosing scope into a `Profiler` node, tracking the nesting of scopes per thread for the self-time
+class ProfileContext {
+ public:
+  explicit ProfileContext(std::size_t id) : id_(id), parent_(current()) {
+    current() = this;
+    begin_    = TscClock::now();
+  }
+  ~ProfileContext() {
+    auto elapsed = (TscClock::now() - begin_).count();
+    current()    = parent_;
+    if (parent_) parent_->children_ += elapsed;
+    Profiler::instance().record(id_, elapsed, children_);
+  }
+  ProfileContext(const ProfileContext &)            = delete;
+  ProfileContext &operator=(const ProfileContext &) = delete;
+
+ private:
+  static ProfileContext *&current() noexcept {
+    thread_local ProfileContext *context = nullptr;
+    return context;
+  }
+
+  std::size_t id_;
+  ProfileContext *parent_;
+  TscClock::time_point begin_;
+  std::int64_t children_{};
+};
+
+inline std::size_t Profiler::node(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t parent = kNoParent;
+  for (std::size_t end = 0; end != std::string::npos;) {
+    end               = path.find('/', end + 1);
+    std::string label = path.substr(0, end);
+    auto it           = ids_.find(label);
+    if (it != ids_.end()) {
+      parent = it->second;
+      continue;
+    }
+    LLU_ASSERT(nodes_.size() < kMaxNodes, "Too many profiler nodes (max {}) for '{}'.", kMaxNodes, path);
+    std::size_t id = nodes_.size();
+    nodes_.push_back({label.substr(label.rfind('/') + 1), parent, {}});
+    (parent == kNoParent ? roots_ : nodes_[parent].children).push_back(id);
+    ids_.emplace(label, id);
+    parent = id;
+  }
+  return parent;
+}
+
+inline void Profiler::record(std::size_t id, std::int64_t total_ns, std::int64_t children_ns) noexcept {
+  // Each shard has a single writer, so plain load-store pairs suffice
+  Entry &entry = localShard().entries[id];
+  entry.count.store(entry.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  entry.total.store(entry.total.load(std::memory_order_relaxed) + total_ns, std::memory_order_relaxed);
+  entry.children.store(entry.children.load(std::memory_order_relaxed) + children_ns, std::memory_order_relaxed);
+}
+
+inline Profiler::Shard &Profiler::localShard() {
+  thread_local std::shared_ptr<Shard> shard = [this] {
+    auto created = std::make_shared<Shard>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    shards_.push_back(created);
+    return created;
+  }();
+  return *shard;
+}
+
+inline Profiler::Stats Profiler::collect(std::size_t id) const {
+  Stats stats;
+  std::int64_t children = 0;
+  for (const auto &shard : shards_) {
+    const Entry &entry = shard->entries[id];
+    stats.count += entry.count.load(std::memory_order_relaxed);
+    stats.total += NSec(entry.total.load(std::memory_order_relaxed));
+    children += entry.children.load(std::memory_order_relaxed);
+  }
+  stats.self = stats.total - NSec(children);
+  return stats;
+}
+
+inline Profiler::Stats Profiler::stats(const std::string &path) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = ids_.find(path);
+  if (it == ids_.end()) LLU_ERROR("Unknown profiler node '{}'.", path);
+  return collect(it->second);
+}
+
+inline std::string Profiler::report() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string out = fmt::format("{:<40}{:>10}{:>14}{:>12}{:>14}\n", "name", "count", "total [ms]", "mean [us]",
+                                "self [ms]");
+  for (std::size_t root : roots_) reportNode(out, root, 0);
+  return out;
+}
+
+inline void Profiler::reportNode(std::string &out, std::size_t id, int depth) const {
+  Stats stats = collect(id);
+  auto ms     = [](NSec ns) { return static_cast<double>(ns.count()) / 1e6; };
+  out += fmt::format("{:<40}{:>10}{:>14.3f}{:>12.3f}{:>14.3f}\n", std::string(2 * depth, ' ') + nodes_[id].name,
+                     stats.count, ms(stats.total), ms(stats.mean()) * 1e3, ms(stats.self));
+  for (std::size_t child : nodes_[id].children) reportNode(out, child, depth + 1);
+}
+
+inline void Profiler::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &shard : shards_) {
+    for (auto &entry : shard->entries) {
+      entry.count.store(0, std::memory_order_relaxed);
+      entry.total.store(0, std::memory_order_relaxed);
+      entry.children.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+}  // namespace llu
+
+#define LLU_PROFILE(path)                                                                                  \
+  static const std::size_t LLU_CONCAT(llu_profile_id_, __LINE__) = ::llu::Profiler::instance().node(path); \
+  ::llu::ProfileContext LLU_CONCAT(llu_profile_context_, __LINE__)(LLU_CONCAT(llu_profile_id_, __LINE__))
+
+#endif  // LLU_PROFILER_H_
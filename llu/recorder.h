@@ -0,0 +1,151 @@
+#ifndef LLU_RECORDER_H_
+#define LLU_RECORDER_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <llu/error.h>
+
+namespace llu {
+/**
+ * @brief Ring buffer of fixed-size records in a memory-mapped file, which survives a crash of the process.
+ *
+ * Pushing follows `StaticQueue::emplace_back` and overwrites the oldest record when full. A push is a memcpy into the
+ * shared mapping plus a counter update, without any syscall, and the kernel writes the dirty pages back to the file
+ * even if the process dies. Call `sync()` to also survive a kernel crash or power loss. After a crash, `recover()`
+ * reads the latest records from the file. A recorder does not overwrite the file of a previous run: an existing file at
+ * `path` is moved to `path + ".prev"` first, from where it can still be recovered.
+ */
+template <typename T>
+class FlightRecorder {
+  static_assert(std::is_trivially_copyable<T>::value, "FlightRecorder requires a trivially copyable type.");
+
+ public:
+  FlightRecorder(const std::string &path, std::size_t capacity);
+  FlightRecorder(const FlightRecorder &)            = delete;
+  FlightRecorder &operator=(const FlightRecorder &) = delete;
+  ~FlightRecorder();
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return header_->slots - 1; }
+  [[nodiscard]] std::uint64_t written() const noexcept { return header_->written.load(std::memory_order_relaxed); }
+  void push_back(const T &record) noexcept;
+  // Flushes the mapping to disk, blocking until done
+  void sync() const;
+
+  /**
+   * @brief Reads the latest records of a recorder file, from oldest to newest.
+   *
+   * One spare slot is kept in the file, so the record that was being written when the process died is never returned.
+   */
+  static std::vector<T> recover(const std::string &path, std::size_t max_num = SIZE_MAX);
+
+ private:
+  static constexpr std::uint64_t kMagic = 0x524543524c554c4cULL;  // "LLULRCER"
+
+  struct Header {
+    std::uint64_t magic;
+    std::uint64_t record_size;
+    std::uint64_t slots;
+    std::atomic<std::uint64_t> written;
+  };
+  static constexpr std::size_t kDataOffset = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+  [[nodiscard]] T *records() const noexcept {
+    return reinterpret_cast<T *>(static_cast<char *>(mapping_) + kDataOffset);
+  }
+
+  int fd_{-1};
+  void *mapping_{nullptr};
+  std::size_t mapping_size_{};
+  Header *header_{nullptr};
+  std::size_t index_{};
+};
+
+template <typename T>
+FlightRecorder<T>::FlightRecorder(const std::string &path, std::size_t capacity) {
+  LLU_ASSERT(capacity > 0, "Invalid capacity (0) for flight recorder '{}'.", path);
+  if (::rename(path.c_str(), (path + ".prev").c_str()) != 0 and errno != ENOENT) {
+    LLU_ERROR("Failed to keep the previous flight recorder '{}' ({}).", path, std::strerror(errno));
+  }
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) LLU_ERROR("Failed to open flight recorder '{}' ({}).", path, std::strerror(errno));
+  mapping_size_ = kDataOffset + (capacity + 1) * sizeof(T);
+  if (::ftruncate(fd_, static_cast<off_t>(mapping_size_)) != 0) {
+    ::close(fd_);
+    LLU_ERROR("Failed to resize flight recorder '{}' ({}).", path, std::strerror(errno));
+  }
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(fd_);
+    LLU_ERROR("Failed to map flight recorder '{}' ({}).", path, std::strerror(errno));
+  }
+  header_ = new (mapping_) Header{kMagic, sizeof(T), capacity + 1, {0}};
+}
+
+template <typename T>
+FlightRecorder<T>::~FlightRecorder() {
+  ::munmap(mapping_, mapping_size_);
+  ::close(fd_);
+}
+
+template <typename T>
+void FlightRecorder<T>::push_back(const T &record) noexcept {
+  std::memcpy(records() + index_, &record, sizeof(T));
+  index_ = index_ + 1 == header_->slots ? 0 : index_ + 1;
+  header_->written.store(header_->written.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T>
+void FlightRecorder<T>::sync() const {
+  if (::msync(mapping_, mapping_size_, MS_SYNC) != 0) {
+    LLU_ERROR("Failed to sync flight recorder ({}).", std::strerror(errno));
+  }
+}
+
+template <typename T>
+std::vector<T> FlightRecorder<T>::recover(const std::string &path, std::size_t max_num) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) LLU_ERROR("Failed to open flight recorder '{}' ({}).", path, std::strerror(errno));
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    int error = errno;
+    ::close(fd);
+    LLU_ERROR("Failed to stat flight recorder '{}' ({}).", path, std::strerror(error));
+  }
+  auto file_size = static_cast<std::size_t>(st.st_size);
+  void *mapping  = file_size >= sizeof(Header) ? ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if (mapping == MAP_FAILED) LLU_ERROR("Failed to map flight recorder '{}'.", path);
+
+  const auto *header     = static_cast<const Header *>(mapping);
+  std::uint64_t slots    = header->slots;
+  bool valid             = header->magic == kMagic and header->record_size == sizeof(T) and slots > 1 and
+                           file_size >= kDataOffset + slots * sizeof(T);
+  std::vector<T> result;
+  if (valid) {
+    std::uint64_t written = header->written.load(std::memory_order_acquire);
+    std::uint64_t num     = std::min<std::uint64_t>({written, slots - 1, max_num});
+    const auto *data      = reinterpret_cast<const T *>(static_cast<const char *>(mapping) + kDataOffset);
+    result.resize(num);
+    for (std::uint64_t i{}; i < num; ++i) {
+      std::memcpy(&result[i], data + (written - num + i) % slots, sizeof(T));
+    }
+  }
+  ::munmap(mapping, file_size);
+  if (not valid) LLU_ERROR("Invalid or incompatible flight recorder '{}'.", path);
+  return result;
+}
+}  // namespace llu
+
+#endif  // LLU_RECORDER_H_
@@ -0,0 +1,128 @@
+#ifndef LLU_SPSC_H_
+#define LLU_SPSC_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <llu/const.h>
+#include <llu/math.h>
+
+namespace llu {
+/**
+ * @brief Lock-free single-producer/single-consumer ring buffer.
+ *
+ * The capacity is rounded up to a power of two. `try_push`/`try_emplace` fail when the queue is full, while
+ * `push_back`/`emplace_back` drop the oldest item like `StaticQueue::emplace_back`. The overwriting variants are only
+ * available when `Overwrite` is set, which requires a trivially copyable `T` because the consumer may copy a slot that
+ * is being overwritten and discard the result afterwards.
+ */
+template <typename T, bool Overwrite = false>
+class SpscQueue {
+ public:
+  explicit SpscQueue(std::size_t capacity) : data_(nextPow2<std::size_t>(std::max<std::size_t>(capacity, 1))) {
+    mask_ = data_.size() - 1;
+  }
+  SpscQueue(const SpscQueue &)            = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return data_.size(); }
+  [[nodiscard]] std::size_t size() const noexcept;
+  [[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+  [[nodiscard]] bool is_full() const noexcept { return size() == capacity(); }
+
+  // Producer side
+  // clang-format off
+  bool try_push(T      &&item) { return try_emplace(std::move(item)); }
+  bool try_push(const T &item) { return try_emplace(item); }
+  template <typename... Args> bool try_emplace(Args &&...args);
+  void push_back(T      &&item) { emplace_back(std::move(item)); }
+  void push_back(const T &item) { emplace_back(item); }
+  template <typename... Args> void emplace_back(Args &&...args);
+  // clang-format on
+
+  // Consumer side
+  bool try_pop(T &item);
+  bool peek(T &item) const;
+
+ private:
+  std::vector<T> data_;
+  std::size_t mask_{};
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};  // written by the consumer (or an overwriting producer)
+  std::size_t cached_tail_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};  // written by the producer
+  std::size_t cached_head_{0};
+};
+
+template <typename T, bool Overwrite>
+std::size_t SpscQueue<T, Overwrite>::size() const noexcept {
+  std::size_t head = head_.load(std::memory_order_acquire);
+  std::size_t tail = tail_.load(std::memory_order_acquire);
+  return tail >= head ? tail - head : 0;
+}
+
+template <typename T, bool Overwrite>
+template <typename... Args>
+bool SpscQueue<T, Overwrite>::try_emplace(Args &&...args) {
+  std::size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - cached_head_ == capacity()) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    if (tail - cached_head_ == capacity()) return false;
+  }
+  data_[tail & mask_] = T(std::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, bool Overwrite>
+template <typename... Args>
+void SpscQueue<T, Overwrite>::emplace_back(Args &&...args) {
+  static_assert(Overwrite, "SpscQueue::emplace_back requires the overwriting variant.");
+  static_assert(std::is_trivially_copyable<T>::value, "Overwriting SpscQueue requires a trivially copyable type.");
+  std::size_t tail = tail_.load(std::memory_order_relaxed);
+  std::size_t head = head_.load(std::memory_order_acquire);
+  // Drop the oldest item unless the consumer has just popped it
+  if (tail - head == capacity()) head_.compare_exchange_strong(head, head + 1, std::memory_order_acq_rel);
+  data_[tail & mask_] = T(std::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+}
+
+template <typename T, bool Overwrite>
+bool SpscQueue<T, Overwrite>::try_pop(T &item) {
+  std::size_t head = head_.load(std::memory_order_relaxed);
+  if (Overwrite) {
+    do {
+      if (head == tail_.load(std::memory_order_acquire)) return false;
+      item = data_[head & mask_];
+    } while (not head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel));
+    return true;
+  }
+  if (head == cached_tail_) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    if (head == cached_tail_) return false;
+  }
+  item = std::move(data_[head & mask_]);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, bool Overwrite>
+bool SpscQueue<T, Overwrite>::peek(T &item) const {
+  std::size_t head = head_.load(std::memory_order_acquire);
+  while (head != tail_.load(std::memory_order_acquire)) {
+    item = data_[head & mask_];
+    if (not Overwrite) return true;
+    // Validate that the slot was not reclaimed while being copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::size_t current = head_.load(std::memory_order_acquire);
+    if (current == head) return true;
+    head = current;
+  }
+  return false;
+}
+}  // namespace llu
+
+#endif  // LLU_SPSC_H_
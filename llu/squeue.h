@@ -1,46 +1,135 @@
 #ifndef LLU_SQUEUE_H_
 #define LLU_SQUEUE_H_
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <exception>
-#include <vector>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <llu/math.h>
 
 namespace llu {
-template <typename T>
+namespace impl {
+// Random access iterator over the items of a ring buffer, from oldest to newest
+template <typename Queue, bool Const>
+class RingIterator {
+  using QueuePtr = std::conditional_t<Const, const Queue *, Queue *>;
+  using T        = typename Queue::value_type;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type        = T;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = std::conditional_t<Const, const T *, T *>;
+  using reference         = std::conditional_t<Const, const T &, T &>;
+
+  constexpr RingIterator() = default;
+  constexpr explicit RingIterator(QueuePtr q, std::size_t idx = 0) : q_(q), idx_(idx) {}
+  template <bool OtherConst, typename = std::enable_if_t<Const and not OtherConst>>
+  constexpr RingIterator(const RingIterator<Queue, OtherConst> &other)  // NOLINT: implicit conversion
+      : q_(other.q_), idx_(other.idx_) {}
+
+  // clang-format off
+  constexpr reference operator*() const { return q_->unchecked(idx_); }
+  constexpr pointer operator->() const { return &operator*(); }
+  constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+  constexpr RingIterator &operator++() { ++idx_; return *this; }
+  constexpr RingIterator &operator--() { --idx_; return *this; }
+  constexpr RingIterator operator++(int) { RingIterator it = *this; ++idx_; return it; }
+  constexpr RingIterator operator--(int) { RingIterator it = *this; --idx_; return it; }
+  constexpr RingIterator &operator+=(difference_type n) { idx_ += n; return *this; }
+  constexpr RingIterator &operator-=(difference_type n) { idx_ -= n; return *this; }
+  constexpr RingIterator operator+(difference_type n) const { return RingIterator(q_, idx_ + n); }
+  constexpr RingIterator operator-(difference_type n) const { return RingIterator(q_, idx_ - n); }
+  friend constexpr RingIterator operator+(difference_type n, const RingIterator &it) { return it + n; }
+  constexpr difference_type operator-(const RingIterator &other) const {
+    return static_cast<difference_type>(idx_ - other.idx_);
+  }
+
+  constexpr bool operator==(const RingIterator &other) const { return idx_ == other.idx_ && q_ == other.q_; }
+  constexpr bool operator!=(const RingIterator &other) const { return idx_ != other.idx_ || q_ != other.q_; }
+  constexpr bool operator<(const RingIterator &other) const { return idx_ < other.idx_; }
+  constexpr bool operator>(const RingIterator &other) const { return idx_ > other.idx_; }
+  constexpr bool operator<=(const RingIterator &other) const { return idx_ <= other.idx_; }
+  constexpr bool operator>=(const RingIterator &other) const { return idx_ >= other.idx_; }
+  // clang-format on
+
+ private:
+  template <typename, bool>
+  friend class RingIterator;
+  QueuePtr q_      = nullptr;
+  std::size_t idx_ = 0;
+};
+}  // namespace impl
+
+/**
+ * @brief Fixed-capacity ring buffer that overwrites its oldest item when full.
+ *
+ * Items live in uninitialized storage and are constructed in place. With `Pow2` set, the capacity is rounded up to a
+ * power of two so that indices are wrapped by masking.
+ */
+template <typename T, bool Pow2 = false>
 class StaticQueue {
  public:
+  using value_type = T;
+
   StaticQueue() = default;
-  explicit StaticQueue(std::size_t capacity) : data_(capacity), capacity_(capacity) {}
+  explicit StaticQueue(std::size_t capacity) { allocate(capacity); }
+  StaticQueue(const StaticQueue &other);
+  StaticQueue(StaticQueue &&other) noexcept { swap(other); }
+  StaticQueue &operator=(StaticQueue other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~StaticQueue() { clear_all(); }
   void allocate(std::size_t size);
+  void swap(StaticQueue &other) noexcept;
 
   // clang-format off
   [[nodiscard]] bool is_empty() const noexcept { return size_ == 0; }
   [[nodiscard]] bool is_full() const noexcept { return size_ == capacity_; }
   [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
 
-  void push_back(T      &&item) noexcept { emplace_back(std::move(item)); }
-  void push_back(const T &item) noexcept { emplace_back(item); }
+  void push_back(T      &&item) { emplace_back(std::move(item)); }
+  void push_back(const T &item) { emplace_back(item); }
   template<typename...Args> void emplace_back(Args &&...args);
+  template<typename InputIt> void push_range(InputIt first, InputIt last);
+  template<typename OutputIt> OutputIt copy_out(OutputIt dest) const;
 
   [[nodiscard]] T       &front()       { assert_not_empty(); return data_[front_]; }
   [[nodiscard]] const T &front() const { assert_not_empty(); return data_[front_]; }
-  [[nodiscard]] T       &back()        { assert_not_empty(); return data_[(front_ + size_ - 1) % capacity_]; }
-  [[nodiscard]] const T &back()  const { assert_not_empty(); return data_[(front_ + size_ - 1) % capacity_]; }
+  [[nodiscard]] T       &back()        { assert_not_empty(); return data_[wrap(front_ + size_ - 1)]; }
+  [[nodiscard]] const T &back()  const { assert_not_empty(); return data_[wrap(front_ + size_ - 1)]; }
   [[nodiscard]] T       &at(int64_t idx)       { return data_[get_index(idx)]; }
   [[nodiscard]] const T &at(int64_t idx) const { return data_[get_index(idx)]; }
   [[nodiscard]] T        get(int64_t idx, const T &default_value) const;
   [[nodiscard]] const T &get_padded(int64_t idx) const;
   // clang-format on
 
-  void clear() noexcept { front_ = size_ = 0; }
-  void clear_all() noexcept {
-    clear();
-    data_.clear();
-    capacity_ = 0;
-  }
+  void pop_front();
+  void clear() noexcept;
+  void clear_all() noexcept;
+
+  template <typename U>
+  struct Segment {
+    U *data;
+    std::size_t size;
+    [[nodiscard]] U *begin() const noexcept { return data; }
+    [[nodiscard]] U *end() const noexcept { return data + size; }
+  };
+  // The items as two contiguous segments, from oldest to newest
+  [[nodiscard]] std::pair<Segment<T>, Segment<T>> segments() noexcept;
+  [[nodiscard]] std::pair<Segment<const T>, Segment<const T>> segments() const noexcept;
 
-  struct iterator;
-  struct const_iterator;
+  using iterator       = impl::RingIterator<StaticQueue, false>;
+  using const_iterator = impl::RingIterator<StaticQueue, true>;
   // clang-format off
   iterator       begin()       { return iterator(this);              }
   const_iterator begin() const { return const_iterator(this);        }
@@ -56,97 +145,275 @@ class StaticQueue {
   void assert_not_empty() const {
     if (is_empty()) throw EmptyQueue();
   }
-  [[nodiscard]] int64_t get_index(int64_t idx) const;
+  // Maps a physical index in [0, 2 * capacity) into the storage
+  [[nodiscard]] std::size_t wrap(std::size_t idx) const noexcept {
+    if (Pow2) return idx & (capacity_ - 1);
+    return idx >= capacity_ ? idx - capacity_ : idx;
+  }
+  [[nodiscard]] std::size_t get_index(int64_t idx) const;
+  [[nodiscard]] T &unchecked(std::size_t idx) noexcept { return data_[wrap(front_ + idx)]; }
+  [[nodiscard]] const T &unchecked(std::size_t idx) const noexcept { return data_[wrap(front_ + idx)]; }
+  friend iterator;
+  friend const_iterator;
 
-  std::vector<T> data_{};
+  T *data_ = nullptr;
   std::size_t front_ = 0, size_ = 0;
   std::size_t capacity_ = 0;
 };
 
-template <typename T>
-void StaticQueue<T>::allocate(std::size_t size) {
-  if (data_.empty()) {
-    data_.resize(size);
-    capacity_ = size;
-  } else {
-    std::vector<T> temp(size);
-    std::size_t start = 0, copy_num = std::min(size, size_);
-    if (size_ > size) start = size_ - size;
-    for (std::size_t i{}; i < copy_num; ++i) {
-      temp[i] = at(start + i);
-    }
-    if (size_ > size) size_ = size;
-    front_    = 0;
-    capacity_ = size;
-    data_     = std::move(temp);
+template <typename T, bool Pow2>
+StaticQueue<T, Pow2>::StaticQueue(const StaticQueue &other) {
+  allocate(other.capacity_);
+  for (const auto &item : other) emplace_back(item);
+}
+
+template <typename T, bool Pow2>
+void StaticQueue<T, Pow2>::allocate(std::size_t size) {
+  if (Pow2 and size != 0) size = nextPow2(size);
+  StaticQueue temp;
+  if (size != 0) {
+    temp.data_     = std::allocator<T>().allocate(size);
+    temp.capacity_ = size;
   }
+  std::size_t start = size_ > size ? size_ - size : 0;
+  for (std::size_t i{start}; i < size_; ++i) {
+    temp.emplace_back(std::move(data_[wrap(front_ + i)]));
+  }
+  swap(temp);
+}
+
+template <typename T, bool Pow2>
+void StaticQueue<T, Pow2>::swap(StaticQueue &other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(front_, other.front_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
 }
 
-template <typename T>
+template <typename T, bool Pow2>
 template <typename... Args>
-void StaticQueue<T>::emplace_back(Args &&...args) {
+void StaticQueue<T, Pow2>::emplace_back(Args &&...args) {
   if (capacity_ == 0) throw NotAllocated();
   if (is_full()) {
-    front_ = (front_ + 1) % capacity_;
+    T *slot = data_ + front_;
+    front_  = wrap(front_ + 1);
+    // Assigning a whole item reuses its resources and stays valid if the item aliases the overwritten slot, other
+    // arguments may refer to it as well, so the new item is built before overwriting
+    if constexpr (sizeof...(Args) == 1 and std::conjunction_v<std::is_same<std::decay_t<Args>, T>...>) {
+      ((*slot = std::forward<Args>(args)), ...);
+    } else {
+      T item(std::forward<Args>(args)...);
+      *slot = std::move(item);
+    }
+    return;
+  }
+  ::new (static_cast<void *>(data_ + wrap(front_ + size_))) T(std::forward<Args>(args)...);
+  ++size_;
+}
+
+template <typename T, bool Pow2>
+template <typename InputIt>
+void StaticQueue<T, Pow2>::push_range(InputIt first, InputIt last) {
+  if constexpr (std::is_trivially_copyable_v<T> and std::is_pointer_v<InputIt> and
+                std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T>) {
+    if (capacity_ == 0) throw NotAllocated();
+    auto num = static_cast<std::size_t>(last - first);
+    if (num >= capacity_) {
+      std::memcpy(data_, last - capacity_, capacity_ * sizeof(T));
+      front_ = 0;
+      size_  = capacity_;
+      return;
+    }
+    std::size_t pos   = wrap(front_ + size_);
+    std::size_t chunk = std::min(num, capacity_ - pos);
+    std::memcpy(data_ + pos, first, chunk * sizeof(T));
+    std::memcpy(data_, first + chunk, (num - chunk) * sizeof(T));
+    if (size_ + num > capacity_) {
+      front_ = wrap(front_ + size_ + num - capacity_);
+      size_  = capacity_;
+    } else {
+      size_ += num;
+    }
+  } else {
+    for (; first != last; ++first) emplace_back(*first);
+  }
+}
+
+template <typename T, bool Pow2>
+template <typename OutputIt>
+OutputIt StaticQueue<T, Pow2>::copy_out(OutputIt dest) const {
+  if (is_empty()) return dest;
+  auto [first, second] = segments();
+  if constexpr (std::is_trivially_copyable_v<T> and std::is_same_v<OutputIt, T *>) {
+    std::memcpy(dest, first.data, first.size * sizeof(T));
+    std::memcpy(dest + first.size, second.data, second.size * sizeof(T));
+    return dest + size_;
   } else {
-    ++size_;
+    dest = std::copy(first.begin(), first.end(), dest);
+    return std::copy(second.begin(), second.end(), dest);
   }
-  data_[(front_ + size_ - 1) % capacity_] = T(std::forward<Args>(args)...);
 }
 
-template <typename T>
-T StaticQueue<T>::get(int64_t idx, const T &default_value) const {
+template <typename T, bool Pow2>
+T StaticQueue<T, Pow2>::get(int64_t idx, const T &default_value) const {
   if (idx < 0) idx += size_;
   if (idx < 0 or static_cast<std::size_t>(idx) >= size_) return default_value;
-  return data_[(front_ + idx) % capacity_];
+  return data_[wrap(front_ + idx)];
 }
 
-template <typename T>
-const T &StaticQueue<T>::get_padded(int64_t idx) const {
+template <typename T, bool Pow2>
+const T &StaticQueue<T, Pow2>::get_padded(int64_t idx) const {
   if (idx < 0) idx = static_cast<int64_t>(size_) + idx;
   if (idx < 0) return front();
-  if (idx >= size_) return back();
-  return data_[(front_ + idx) % capacity_];
+  if (static_cast<std::size_t>(idx) >= size_) return back();
+  return data_[wrap(front_ + idx)];
 }
 
-template <typename T>
-int64_t StaticQueue<T>::get_index(int64_t idx) const {
+template <typename T, bool Pow2>
+std::size_t StaticQueue<T, Pow2>::get_index(int64_t idx) const {
   if (idx < 0) idx += size_;
   if (idx < 0 or static_cast<std::size_t>(idx) >= size_) throw IndexOutOfRange();
-  return (front_ + idx) % capacity_;
+  return wrap(front_ + idx);
 }
 
-template <typename T>
-struct StaticQueue<T>::iterator {
-  explicit iterator(StaticQueue *q, std::size_t idx = 0) : q_(q), idx_(idx) {}
-  iterator &operator++() {
-    idx_++;
-    return *this;
+template <typename T, bool Pow2>
+void StaticQueue<T, Pow2>::pop_front() {
+  assert_not_empty();
+  std::destroy_at(data_ + front_);
+  front_ = wrap(front_ + 1);
+  --size_;
+}
+
+template <typename T, bool Pow2>
+void StaticQueue<T, Pow2>::clear() noexcept {
+  if constexpr (not std::is_trivially_destructible_v<T>) {
+    for (std::size_t i{}; i < size_; ++i) std::destroy_at(data_ + wrap(front_ + i));
   }
-  bool operator==(iterator other) const { return idx_ == other.idx_ && q_ == other.q_; }
-  bool operator!=(iterator other) const { return idx_ != other.idx_ || q_ != other.q_; }
-  T &operator*() const { return q_->at(idx_); }
+  front_ = size_ = 0;
+}
+
+template <typename T, bool Pow2>
+void StaticQueue<T, Pow2>::clear_all() noexcept {
+  clear();
+  if (data_ != nullptr) std::allocator<T>().deallocate(data_, capacity_);
+  data_     = nullptr;
+  capacity_ = 0;
+}
+
+template <typename T, bool Pow2>
+auto StaticQueue<T, Pow2>::segments() noexcept -> std::pair<Segment<T>, Segment<T>> {
+  std::size_t first = std::min(size_, capacity_ - front_);
+  return {{data_ + front_, first}, {data_, size_ - first}};
+}
+
+template <typename T, bool Pow2>
+auto StaticQueue<T, Pow2>::segments() const noexcept -> std::pair<Segment<const T>, Segment<const T>> {
+  std::size_t first = std::min(size_, capacity_ - front_);
+  return {{data_ + front_, first}, {data_, size_ - first}};
+}
+
+
+/**
+ * @brief `StaticQueue` with a compile-time capacity and inline storage.
+ *
+ * Slots are default-constructed in a `std::array`, so the queue never allocates and can be used in constant
+ * expressions, on the stack or as a member of aligned Eigen structs.
+ */
+template <typename T, std::size_t N>
+class FixedQueue {
+  static_assert(N > 0, "FixedQueue: Invalid capacity (0).");
+
+ public:
+  using value_type      = T;
+  using EmptyQueue      = typename StaticQueue<T>::EmptyQueue;
+  using IndexOutOfRange = typename StaticQueue<T>::IndexOutOfRange;
+
+  constexpr FixedQueue() = default;
+
+  // clang-format off
+  [[nodiscard]] constexpr bool is_empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] constexpr bool is_full() const noexcept { return size_ == N; }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+
+  constexpr void push_back(T      &&item) { emplace_back(std::move(item)); }
+  constexpr void push_back(const T &item) { emplace_back(item); }
+  template<typename...Args> constexpr void emplace_back(Args &&...args);
+
+  [[nodiscard]] constexpr T       &front()       { assert_not_empty(); return data_[front_]; }
+  [[nodiscard]] constexpr const T &front() const { assert_not_empty(); return data_[front_]; }
+  [[nodiscard]] constexpr T       &back()        { assert_not_empty(); return data_[wrap(front_ + size_ - 1)]; }
+  [[nodiscard]] constexpr const T &back()  const { assert_not_empty(); return data_[wrap(front_ + size_ - 1)]; }
+  [[nodiscard]] constexpr T       &at(int64_t idx)       { return data_[get_index(idx)]; }
+  [[nodiscard]] constexpr const T &at(int64_t idx) const { return data_[get_index(idx)]; }
+  [[nodiscard]] constexpr T        get(int64_t idx, const T &default_value) const;
+  [[nodiscard]] constexpr const T &get_padded(int64_t idx) const;
+  // clang-format on
+
+  constexpr void clear() noexcept { front_ = size_ = 0; }
+
+  using iterator       = impl::RingIterator<FixedQueue, false>;
+  using const_iterator = impl::RingIterator<FixedQueue, true>;
+  // clang-format off
+  constexpr iterator       begin()       { return iterator(this);              }
+  constexpr const_iterator begin() const { return const_iterator(this);        }
+  constexpr iterator       end()         { return iterator(this, size_);       }
+  constexpr const_iterator end()   const { return const_iterator(this, size_); }
+  // clang-format on
 
  private:
-  StaticQueue *q_;
-  std::size_t idx_;
+  constexpr void assert_not_empty() const {
+    if (is_empty()) throw EmptyQueue();
+  }
+  // Maps a physical index in [0, 2 * N) into the storage
+  [[nodiscard]] static constexpr std::size_t wrap(std::size_t idx) noexcept {
+    if constexpr ((N & (N - 1)) == 0) return idx & (N - 1);
+    return idx >= N ? idx - N : idx;
+  }
+  [[nodiscard]] constexpr std::size_t get_index(int64_t idx) const {
+    if (idx < 0) idx += size_;
+    if (idx < 0 or static_cast<std::size_t>(idx) >= size_) throw IndexOutOfRange();
+    return wrap(front_ + idx);
+  }
+  [[nodiscard]] constexpr T &unchecked(std::size_t idx) noexcept { return data_[wrap(front_ + idx)]; }
+  [[nodiscard]] constexpr const T &unchecked(std::size_t idx) const noexcept { return data_[wrap(front_ + idx)]; }
+  friend iterator;
+  friend const_iterator;
+
+  std::array<T, N> data_{};
+  std::size_t front_ = 0, size_ = 0;
 };
 
-template <typename T>
-struct StaticQueue<T>::const_iterator {
-  explicit const_iterator(const StaticQueue *q, std::size_t idx = 0) : q_(q), idx_(idx) {}
-  const_iterator &operator++() {
-    idx_++;
-    return *this;
+template <typename T, std::size_t N>
+template <typename... Args>
+constexpr void FixedQueue<T, N>::emplace_back(Args &&...args) {
+  std::size_t idx = front_;
+  if (is_full()) {
+    front_ = wrap(front_ + 1);
+  } else {
+    idx = wrap(front_ + size_++);
+  }
+  if constexpr (sizeof...(Args) == 1 and std::conjunction_v<std::is_same<std::decay_t<Args>, T>...>) {
+    ((data_[idx] = std::forward<Args>(args)), ...);
+  } else {
+    data_[idx] = T(std::forward<Args>(args)...);
   }
-  bool operator==(const_iterator other) const { return idx_ == other.idx_ && q_ == other.q_; }
-  bool operator!=(const_iterator other) const { return idx_ != other.idx_ || q_ != other.q_; }
-  const T &operator*() const { return q_->at(idx_); }
+}
 
- private:
-  const StaticQueue *q_;
-  std::size_t idx_;
-};
+template <typename T, std::size_t N>
+constexpr T FixedQueue<T, N>::get(int64_t idx, const T &default_value) const {
+  if (idx < 0) idx += size_;
+  if (idx < 0 or static_cast<std::size_t>(idx) >= size_) return default_value;
+  return data_[wrap(front_ + idx)];
+}
+
+template <typename T, std::size_t N>
+constexpr const T &FixedQueue<T, N>::get_padded(int64_t idx) const {
+  if (idx < 0) idx = static_cast<int64_t>(size_) + idx;
+  if (idx < 0) return front();
+  if (static_cast<std::size_t>(idx) >= size_) return back();
+  return data_[wrap(front_ + idx)];
+}
 }  // namespace llu
 
 #endif  // LLU_SQUEUE_H_
@@ -0,0 +1,210 @@
+#ifndef LLU_STATS_H_
+#define LLU_STATS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <llu/eigen.h>
+#include <llu/error.h>
+#include <llu/macro.h>
+#include <llu/math.h>
+#include <llu/squeue.h>
+
+namespace llu {
+namespace impl {
+// Monotonic ring of (sequence, value) pairs whose front is the extremum of the window according to `Compare`
+template <typename T, typename Compare>
+class MonotonicRing {
+ public:
+  void allocate(std::size_t capacity) {
+    seqs_.assign(capacity, 0);
+    values_.assign(capacity, T{});
+    head_ = size_ = 0;
+  }
+  void clear() noexcept { head_ = size_ = 0; }
+
+  void push(std::uint64_t seq, T value) {
+    while (size_ != 0 and not Compare()(values_[index(size_ - 1)], value)) --size_;
+    seqs_[index(size_)]   = seq;
+    values_[index(size_)] = value;
+    ++size_;
+  }
+  void evict(std::uint64_t seq) {
+    if (size_ != 0 and seqs_[head_] == seq) {
+      head_ = index(1);
+      --size_;
+    }
+  }
+  [[nodiscard]] T front() const { return values_[head_]; }
+
+ private:
+  [[nodiscard]] std::size_t index(std::size_t idx) const noexcept {
+    idx += head_;
+    return idx >= seqs_.size() ? idx - seqs_.size() : idx;
+  }
+
+  std::vector<std::uint64_t> seqs_;
+  std::vector<T> values_;
+  std::size_t head_{}, size_{};
+};
+}  // namespace impl
+
+/**
+ * @brief Statistics over a sliding window of the latest `capacity` samples.
+ *
+ * The window follows `StaticQueue` semantics. Mean and variance are updated incrementally when a sample enters or
+ * leaves the window, minimum and maximum are tracked with monotonic rings in amortized O(1), and a sorted copy of the
+ * window answers median and quantile queries in O(1) at the cost of a binary search plus a memmove per sample. No
+ * allocation happens after construction. Non-finite samples would break the ordering of the sorted copy, so they are
+ * rejected with an exception. Element-wise statistics are available through `WindowStats<ArrXf>`.
+ */
+template <typename T>
+class WindowStats {
+  LLU_ASSERT_FP(T);
+
+ public:
+  WindowStats() = default;
+  explicit WindowStats(std::size_t capacity) { allocate(capacity); }
+  void allocate(std::size_t capacity);
+  void clear();
+
+  void push_back(T sample);
+
+  [[nodiscard]] std::size_t size() const noexcept { return window_.size(); }
+  [[nodiscard]] std::size_t capacity() const noexcept { return window_.capacity(); }
+  [[nodiscard]] bool is_empty() const noexcept { return window_.is_empty(); }
+  [[nodiscard]] const StaticQueue<T> &window() const noexcept { return window_; }
+
+  [[nodiscard]] T mean() const { return static_cast<T>(mean_); }
+  // Population variance of the window
+  [[nodiscard]] T var() const { return is_empty() ? T{} : static_cast<T>(std::max(m2_, 0.) / size()); }
+  [[nodiscard]] T stddev() const { return std::sqrt(var()); }
+  [[nodiscard]] T min() const { return is_empty() ? T{} : min_.front(); }
+  [[nodiscard]] T max() const { return is_empty() ? T{} : max_.front(); }
+  [[nodiscard]] T median() const { return quantile(0.5); }
+  [[nodiscard]] T quantile(double q) const;
+
+ private:
+  StaticQueue<T> window_;
+  std::vector<T> sorted_;
+  impl::MonotonicRing<T, std::less<T>> min_;
+  impl::MonotonicRing<T, std::greater<T>> max_;
+  std::uint64_t seq_{};
+  double mean_{}, m2_{};
+};
+
+template <typename T>
+void WindowStats<T>::allocate(std::size_t capacity) {
+  window_.clear_all();
+  window_.allocate(capacity);
+  sorted_.clear();
+  sorted_.reserve(capacity);
+  min_.allocate(capacity);
+  max_.allocate(capacity);
+  seq_  = 0;
+  mean_ = m2_ = 0.;
+}
+
+template <typename T>
+void WindowStats<T>::clear() {
+  window_.clear();
+  sorted_.clear();
+  min_.clear();
+  max_.clear();
+  seq_  = 0;
+  mean_ = m2_ = 0.;
+}
+
+template <typename T>
+void WindowStats<T>::push_back(T sample) {
+  LLU_ASSERT(std::isfinite(sample), "Window statistics only take finite samples, got {}.", sample);
+  if (window_.is_full()) {
+    T oldest = window_.front();
+    min_.evict(seq_ - size());
+    max_.evict(seq_ - size());
+    auto it = std::lower_bound(sorted_.begin(), sorted_.end(), oldest);
+    if (it != sorted_.end() and *it == oldest) sorted_.erase(it);
+    // Welford's update in reverse
+    double n     = static_cast<double>(size()) - 1.;
+    double delta = static_cast<double>(oldest) - mean_;
+    mean_        = n > 0 ? mean_ - delta / n : 0.;
+    m2_ -= delta * (static_cast<double>(oldest) - mean_);
+  }
+  window_.push_back(sample);
+  min_.push(seq_, sample);
+  max_.push(seq_, sample);
+  sorted_.insert(std::upper_bound(sorted_.begin(), sorted_.end(), sample), sample);
+  ++seq_;
+
+  double delta = static_cast<double>(sample) - mean_;
+  mean_ += delta / static_cast<double>(size());
+  m2_ += delta * (static_cast<double>(sample) - mean_);
+}
+
+template <typename T>
+T WindowStats<T>::quantile(double q) const {
+  if (is_empty()) return T{};
+  // Linear interpolation between the closest ranks
+  double rank    = clamp(q, 0., 1.) * static_cast<double>(sorted_.size() - 1);
+  auto lower     = static_cast<std::size_t>(rank);
+  std::size_t up = std::min(lower + 1, sorted_.size() - 1);
+  auto frac      = static_cast<T>(rank - static_cast<double>(lower));
+  return sorted_[lower] + (sorted_[up] - sorted_[lower]) * frac;
+}
+
+/**
+ * @brief Element-wise `WindowStats` over a window of arrays, all of the same dimension.
+ */
+template <typename T>
+class WindowStats<Eigen::Array<T, Eigen::Dynamic, 1>> {
+  using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+ public:
+  WindowStats() = default;
+  WindowStats(Eigen::Index dim, std::size_t capacity) { allocate(dim, capacity); }
+  void allocate(Eigen::Index dim, std::size_t capacity) {
+    stats_.clear();
+    stats_.reserve(dim);
+    for (Eigen::Index i{}; i < dim; ++i) stats_.emplace_back(capacity);
+  }
+  void clear() {
+    for (auto &stats : stats_) stats.clear();
+  }
+
+  void push_back(const Eigen::Ref<const Array> &sample) {
+    LLU_ASSERT(sample.size() == dim(), "Sample of size {} does not match the window dimension {}.", sample.size(),
+               dim());
+    for (Eigen::Index i{}; i < dim(); ++i) stats_[i].push_back(sample[i]);
+  }
+
+  [[nodiscard]] Eigen::Index dim() const noexcept { return static_cast<Eigen::Index>(stats_.size()); }
+  [[nodiscard]] std::size_t size() const noexcept { return stats_.empty() ? 0 : stats_.front().size(); }
+  [[nodiscard]] std::size_t capacity() const noexcept { return stats_.empty() ? 0 : stats_.front().capacity(); }
+  [[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+
+  // clang-format off
+  [[nodiscard]] Array mean()   const { return apply([](const WindowStats<T> &s) { return s.mean(); }); }
+  [[nodiscard]] Array var()    const { return apply([](const WindowStats<T> &s) { return s.var(); }); }
+  [[nodiscard]] Array stddev() const { return apply([](const WindowStats<T> &s) { return s.stddev(); }); }
+  [[nodiscard]] Array min()    const { return apply([](const WindowStats<T> &s) { return s.min(); }); }
+  [[nodiscard]] Array max()    const { return apply([](const WindowStats<T> &s) { return s.max(); }); }
+  [[nodiscard]] Array median() const { return apply([](const WindowStats<T> &s) { return s.median(); }); }
+  [[nodiscard]] Array quantile(double q) const { return apply([q](const WindowStats<T> &s) { return s.quantile(q); }); }
+  // clang-format on
+
+ private:
+  template <typename Func>
+  [[nodiscard]] Array apply(Func func) const {
+    Array result(dim());
+    for (Eigen::Index i{}; i < dim(); ++i) result[i] = func(stats_[i]);
+    return result;
+  }
+
+  std::vector<WindowStats<T>> stats_;
+};
+}  // namespace llu
+
+#endif  // LLU_STATS_H_
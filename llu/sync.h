@@ -0,0 +1,97 @@
+#ifndef LLU_SYNC_H_
+#define LLU_SYNC_H_
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include <llu/chrono.h>
+#include <llu/tqueue.h>
+
+namespace llu {
+enum class SyncPolicy {
+  kExact,        // timestamps of a matched tuple are all equal
+  kApproximate,  // timestamps of a matched tuple are within the maximal skew
+};
+
+/**
+ * @brief Matches messages of several typed streams by timestamp.
+ *
+ * Each stream is buffered in a bounded `TimedQueue`, and timestamps of a stream must be non-decreasing. Whenever every
+ * stream has a message, the latest head timestamp is taken as the pivot: heads superseded by a later message that is
+ * not after the pivot, or too old to ever match it, are dropped, and once all heads lie within the skew they are
+ * emitted as one tuple. Every message is dropped or emitted once, so the cost per message is bounded, and no
+ * allocation happens after construction.
+ */
+template <typename... Ts>
+class Synchronizer {
+  static_assert(sizeof...(Ts) >= 2, "Synchronizer requires at least two streams.");
+
+ public:
+  using Callback = std::function<void(const Stamped<Ts> &...)>;
+
+  Synchronizer(std::size_t queue_size, Duration max_skew, SyncPolicy policy = SyncPolicy::kApproximate)
+      : max_skew_(policy == SyncPolicy::kExact ? Duration::zero() : max_skew) {
+    std::apply([queue_size](auto &...queues) { (queues.allocate(queue_size), ...); }, queues_);
+  }
+
+  void setCallback(Callback callback) { callback_ = std::move(callback); }
+
+  template <std::size_t I, typename U>
+  void push(TimePoint time, U &&value) {
+    std::get<I>(queues_).push_back(time, std::forward<U>(value));
+    process();
+  }
+
+  [[nodiscard]] std::size_t matched() const noexcept { return matched_; }
+  [[nodiscard]] std::size_t dropped() const noexcept { return dropped_; }
+  void clear() {
+    std::apply([](auto &...queues) { (queues.clear(), ...); }, queues_);
+  }
+
+ private:
+  static constexpr auto kIndices = std::index_sequence_for<Ts...>{};
+
+  void process();
+  template <std::size_t... Is>
+  bool tryMatch(std::index_sequence<Is...>);
+  template <typename Queue>
+  bool dropStale(Queue &queue, TimePoint pivot);
+
+  std::tuple<TimedQueue<Ts>...> queues_;
+  Duration max_skew_;
+  Callback callback_;
+  std::size_t matched_{}, dropped_{};
+};
+
+template <typename... Ts>
+void Synchronizer<Ts...>::process() {
+  while (tryMatch(kIndices));
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+bool Synchronizer<Ts...>::tryMatch(std::index_sequence<Is...>) {
+  if ((std::get<Is>(queues_).is_empty() or ...)) return false;
+  TimePoint pivot = std::max({std::get<Is>(queues_).front().time...});
+  // Drop at most one head per stream, then re-evaluate the pivot
+  if ((dropStale(std::get<Is>(queues_), pivot) | ...)) return true;
+  if (callback_) callback_(std::get<Is>(queues_).front()...);
+  (std::get<Is>(queues_).pop_front(), ...);
+  ++matched_;
+  return true;
+}
+
+template <typename... Ts>
+template <typename Queue>
+bool Synchronizer<Ts...>::dropStale(Queue &queue, TimePoint pivot) {
+  bool superseded = queue.size() > 1 and queue.queue().at(1).time <= pivot;
+  if (not superseded and pivot - queue.front().time <= max_skew_) return false;
+  queue.pop_front();
+  ++dropped_;
+  return true;
+}
+}  // namespace llu
+
+#endif  // LLU_SYNC_H_
@@ -0,0 +1,157 @@
+#ifndef LLU_TQUEUE_H_
+#define LLU_TQUEUE_H_
+
+#include <algorithm>
+#include <exception>
+#include <type_traits>
+
+#include <llu/chrono.h>
+#include <llu/error.h>
+#include <llu/geometry.h>
+#include <llu/math.h>
+#include <llu/squeue.h>
+
+namespace llu {
+namespace impl {
+template <typename T, typename = void>
+struct ScalarOf {
+  using type = T;
+};
+
+template <typename T>
+struct ScalarOf<T, std::void_t<typename T::Scalar>> {
+  using type = typename T::Scalar;
+};
+}  // namespace impl
+
+/**
+ * @brief Interpolation between two values, `factor` in [0, 1].
+ *
+ * Linear for floating point scalars and Eigen types, spherical for `Quaternion`. Specialize for other types.
+ */
+template <typename T, typename = void>
+struct Interpolator {
+  static T interpolate(const T &start, const T &end, double factor) {
+    return lerp(start, end, static_cast<typename impl::ScalarOf<T>::type>(factor));
+  }
+};
+
+template <typename T>
+struct Interpolator<Quaternion<T>> {
+  static Quaternion<T> interpolate(const Quaternion<T> &start, const Quaternion<T> &end, double factor) {
+    return start.slerp(end, static_cast<T>(factor));
+  }
+};
+
+template <typename T>
+struct Stamped {
+  TimePoint time;
+  T value;
+};
+
+/**
+ * @brief `StaticQueue` of timestamped values, with timestamps in non-decreasing order.
+ *
+ * Lookups by timestamp are binary searches over the queue, and values between two samples are interpolated through
+ * `Interpolator<T>`.
+ */
+template <typename T>
+class TimedQueue {
+ public:
+  using Queue          = StaticQueue<Stamped<T>>;
+  using const_iterator = typename Queue::const_iterator;
+
+  TimedQueue() = default;
+  explicit TimedQueue(std::size_t capacity) : queue_(capacity) {}
+  void allocate(std::size_t capacity) { queue_.allocate(capacity); }
+
+  // clang-format off
+  [[nodiscard]] bool is_empty() const noexcept { return queue_.is_empty(); }
+  [[nodiscard]] std::size_t size() const noexcept { return queue_.size(); }
+  [[nodiscard]] const Queue &queue() const noexcept { return queue_; }
+  [[nodiscard]] const Stamped<T> &front() const { return queue_.front(); }
+  [[nodiscard]] const Stamped<T> &back()  const { return queue_.back(); }
+  const_iterator begin() const { return queue_.begin(); }
+  const_iterator end()   const { return queue_.end(); }
+  void pop_front() { queue_.pop_front(); }
+  void clear() noexcept { queue_.clear(); }
+
+  struct OutOfOrder final : std::exception { const char *what() const noexcept override { return "Timestamp out of order."; } };
+  // clang-format on
+
+  void push_back(TimePoint time, const T &value);
+
+  // First item whose timestamp is not earlier than `time`
+  [[nodiscard]] const_iterator lower_bound(TimePoint time) const;
+  // Item whose timestamp is closest to `time`
+  [[nodiscard]] const Stamped<T> &nearest(TimePoint time) const;
+  /**
+   * @brief Interpolates the value at `time`.
+   *
+   * @return false if the queue is empty or `time` is outside of the buffered time span.
+   */
+  bool interpolate(TimePoint time, T &value) const;
+
+  /**
+   * @brief Emits interpolated values on the fixed-rate grid `next + k * period` covered by the buffered samples.
+   *
+   * `next` is advanced past the emitted grid points, so calling it again after new samples arrive continues the grid.
+   * Grid points older than the buffered time span are skipped.
+   *
+   * @return The number of emitted values.
+   */
+  template <typename Func>
+  std::size_t resample(TimePoint &next, Duration period, Func &&emit) const;
+
+ private:
+  Queue queue_;
+};
+
+template <typename T>
+void TimedQueue<T>::push_back(TimePoint time, const T &value) {
+  if (not is_empty() and time < back().time) throw OutOfOrder();
+  queue_.push_back({time, value});
+}
+
+template <typename T>
+auto TimedQueue<T>::lower_bound(TimePoint time) const -> const_iterator {
+  return std::lower_bound(begin(), end(), time, [](const Stamped<T> &item, TimePoint t) { return item.time < t; });
+}
+
+template <typename T>
+auto TimedQueue<T>::nearest(TimePoint time) const -> const Stamped<T> & {
+  auto it = lower_bound(time);
+  if (it == end()) return back();
+  if (it == begin()) return *it;
+  auto prev = it - 1;
+  return time - prev->time <= it->time - time ? *prev : *it;
+}
+
+template <typename T>
+bool TimedQueue<T>::interpolate(TimePoint time, T &value) const {
+  if (is_empty() or time < front().time or time > back().time) return false;
+  auto it = lower_bound(time);
+  if (it->time == time or it == begin()) {
+    value = it->value;
+    return true;
+  }
+  const Stamped<T> &prev = *(it - 1);
+  double factor          = std::chrono::duration<double>(time - prev.time) / (it->time - prev.time);
+  value                  = Interpolator<T>::interpolate(prev.value, it->value, factor);
+  return true;
+}
+
+template <typename T>
+template <typename Func>
+std::size_t TimedQueue<T>::resample(TimePoint &next, Duration period, Func &&emit) const {
+  LLU_ASSERT(period.count() > 0, "Resampling period must be positive, got {} ns.", duration_cast<NSec>(period).count());
+  if (is_empty()) return 0;
+  if (next < front().time) next += ceilDiv((front().time - next).count(), period.count()) * period;
+  std::size_t count = 0;
+  T value;
+  for (; interpolate(next, value); next += period, ++count) emit(next, value);
+  return count;
+}
+}  // namespace llu
+
+#endif  // LLU_TQUEUE_H_
@@ -0,0 +1,196 @@
+#ifndef LLU_TRACE_H_
+#define LLU_TRACE_H_
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <llu/chrono.h>
+#include <llu/error.h>
+#include <llu/macro.h>
+#include <llu/spsc.h>
+
+namespace llu {
+namespace impl {
+// Writes `text` escaped as the contents of a JSON string
+inline void printJsonEscaped(std::FILE *file, const char *text) {
+  for (; *text != '\0'; ++text) {
+    auto c = static_cast<unsigned char>(*text);
+    if (c == '"' or c == '\\') {
+      std::fputc('\\', file);
+      std::fputc(c, file);
+    } else if (c < 0x20) {
+      fmt::print(file, "\\u{:04x}", c);
+    } else {
+      std::fputc(c, file);
+    }
+  }
+}
+}  // namespace impl
+
+struct TraceEvent {
+  const char *name;
+  TimePoint begin, end;
+};
+
+/**
+ * @brief Collects scope timings of all threads into a Chrome trace-event file, which opens in Perfetto.
+ *
+ * Every thread records into its own `SpscQueue`, registered on its first event, and a background thread drains the
+ * queues into the file periodically. Recording costs two clock reads and a queue push. Events are dropped and counted
+ * when a queue is full, so the recording thread never blocks. Event names must outlive the tracer, e.g. be literals.
+ */
+class Tracer {
+ public:
+  static constexpr std::size_t kBufferSize = 8192;
+
+  static Tracer &instance() {
+    static Tracer tracer;
+    return tracer;
+  }
+  Tracer(const Tracer &)            = delete;
+  Tracer &operator=(const Tracer &) = delete;
+  ~Tracer() { stop(); }
+
+  // Opens the trace file, enables tracing and starts flushing every `period`
+  void start(const std::string &path, Duration period = MSec(100));
+  // Disables tracing, flushes the remaining events and closes the file
+  void stop();
+
+  // Pauses or resumes recording without closing the file
+  static void setEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+  [[nodiscard]] static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  void record(const TraceEvent &event) noexcept;
+  // Number of events dropped because a thread buffer was full
+  [[nodiscard]] std::size_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Buffer {
+    SpscQueue<TraceEvent> queue{kBufferSize};
+    int tid;
+  };
+
+  Tracer() = default;
+  Buffer &localBuffer();
+  void flush();
+
+  static inline std::atomic<bool> enabled_{false};
+
+  std::mutex mutex_;  // guards the buffer list and the file
+  std::vector<std::shared_ptr<Buffer>> buffers_;
+  std::FILE *file_{nullptr};
+  bool first_event_{true};
+  int next_tid_{};
+  std::atomic<std::size_t> dropped_{0};
+
+  std::thread thread_;
+  std::condition_variable cv_;
+  bool stopping_{false};
+};
+
+/**
+ * @brief Records the lifetime of a scope into the `Tracer`, the timeline counterpart of `TimerContext`.
+ *
+ * Costs a relaxed load when tracing is disabled.
+ */
+class TraceContext {
+ public:
+  explicit TraceContext(const char *name) : name_(name) {
+    if (Tracer::enabled()) begin_ = Clock::now();
+  }
+  ~TraceContext() {
+    if (begin_ != TimePoint{}) Tracer::instance().record({name_, begin_, Clock::now()});
+  }
+  TraceContext(const TraceContext &)            = delete;
+  TraceContext &operator=(const TraceContext &) = delete;
+
+ private:
+  const char *name_;
+  TimePoint begin_{};
+};
+
+inline void Tracer::start(const std::string &path, Duration period) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (file_) LLU_ERROR("Tracer is already writing to a file.");
+  file_ = std::fopen(path.c_str(), "w");
+  if (not file_) LLU_ERROR("Failed to open trace file '{}' ({}).", path, std::strerror(errno));
+  std::fputs("[\n", file_);
+  first_event_ = true;
+  stopping_    = false;
+  thread_      = std::thread([this, period] {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not cv_.wait_for(lock, period, [this] { return stopping_; })) flush();
+  });
+  setEnabled(true);
+}
+
+inline void Tracer::stop() {
+  setEnabled(false);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (not file_) return;
+  flush();
+  std::fputs("\n]\n", file_);
+  std::fclose(file_);
+  file_ = nullptr;
+}
+
+inline void Tracer::record(const TraceEvent &event) noexcept {
+  if (not localBuffer().queue.try_push(event)) dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline Tracer::Buffer &Tracer::localBuffer() {
+  thread_local std::shared_ptr<Buffer> buffer = [this] {
+    auto created = std::make_shared<Buffer>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    created->tid = next_tid_++;
+    buffers_.push_back(created);
+    return created;
+  }();
+  return *buffer;
+}
+
+inline void Tracer::flush() {
+  if (not file_) return;
+  int pid = static_cast<int>(::getpid());
+  for (auto &buffer : buffers_) {
+    TraceEvent event;
+    while (buffer->queue.try_pop(event)) {
+      auto begin = duration_cast<NSec>(event.begin.time_since_epoch()).count();
+      auto dur   = duration_cast<NSec>(event.end - event.begin).count();
+      fmt::print(file_, R"({}{{"name":")", first_event_ ? "" : ",\n");
+      impl::printJsonEscaped(file_, event.name);
+      fmt::print(file_, R"(","ph":"X","pid":{},"tid":{},"ts":{:.3f},"dur":{:.3f}}})", pid, buffer->tid, begin / 1e3,
+                 dur / 1e3);
+      first_event_ = false;
+    }
+  }
+  // Release the buffers of exited threads once drained
+  buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                [](const auto &buffer) { return buffer.use_count() == 1 and buffer->queue.is_empty(); }),
+                 buffers_.end());
+  std::fflush(file_);
+}
+}  // namespace llu
+
+#define LLU_TRACE_SCOPE(name) ::llu::TraceContext LLU_CONCAT(llu_trace_scope_, __LINE__)(name)
+
+#endif  // LLU_TRACE_H_
@@ -0,0 +1,161 @@
+#ifndef LLU_WATCHDOG_H_
+#define LLU_WATCHDOG_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llu/chrono.h>
+#include <llu/const.h>
+#include <llu/error.h>
+#include <llu/squeue.h>
+
+namespace llu {
+struct Overrun {
+  std::size_t loop;  // index of the heartbeat, in order of registration
+  TimePoint time;    // when the miss was detected
+  Duration stalled;  // time since the last observed kick
+};
+
+/**
+ * @brief Heartbeat of a monitored loop, kicked by the loop once per cycle.
+ *
+ * A kick is a relaxed load and store of a counter on its own cache line, without reading the clock. The monitor
+ * notices whether the counter moved since its last check, so deadlines are resolved to the check period.
+ */
+class Heartbeat {
+ public:
+  void kick() noexcept { beats_.store(beats_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+  [[nodiscard]] const std::string &name() const noexcept { return name_; }
+  [[nodiscard]] Duration deadline() const noexcept { return deadline_; }
+  [[nodiscard]] std::size_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class Watchdog;
+
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> beats_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> misses_{0};
+  std::string name_;
+  Duration deadline_;
+  std::function<void(const Overrun &)> callback_;
+  // Monitor state
+  std::uint64_t last_beats_{};
+  TimePoint last_change_;
+  bool stalled_{false};
+};
+
+/**
+ * @brief Checks the heartbeats of several loops from a monitor thread.
+ *
+ * A loop misses its deadline when its heartbeat has not been kicked for longer than the deadline. The miss is
+ * reported once per stall: the callback of the heartbeat is called from the monitor thread and the overrun is kept in
+ * a bounded history. The heartbeat re-arms with its next kick.
+ */
+class Watchdog {
+ public:
+  using Callback = std::function<void(const Overrun &)>;
+
+  explicit Watchdog(Duration check_period = MSec(1), std::size_t history = 64)
+      : check_period_(check_period), history_(history) {}
+  Watchdog(const Watchdog &)            = delete;
+  Watchdog &operator=(const Watchdog &) = delete;
+  ~Watchdog() { stop(); }
+
+  // The heartbeat stays valid for the lifetime of the watchdog
+  Heartbeat &add(std::string name, Duration deadline, Callback callback = {});
+
+  void start();
+  void stop();
+
+  // Recorded overruns, from oldest to newest
+  [[nodiscard]] std::vector<Overrun> overruns() const;
+
+ private:
+  void check();
+
+  Duration check_period_;
+  mutable std::mutex mutex_;  // guards the heartbeat list, the history and the stop flag
+  std::vector<std::unique_ptr<Heartbeat>> heartbeats_;
+  StaticQueue<Overrun> history_;
+  std::thread thread_;
+  std::condition_variable cv_;
+  bool stopping_{false};
+};
+
+inline Heartbeat &Watchdog::add(std::string name, Duration deadline, Callback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto heartbeat          = std::make_unique<Heartbeat>();
+  heartbeat->name_        = std::move(name);
+  heartbeat->deadline_    = deadline;
+  heartbeat->callback_    = std::move(callback);
+  heartbeat->last_change_ = Clock::now();
+  heartbeats_.push_back(std::move(heartbeat));
+  return *heartbeats_.back();
+}
+
+inline void Watchdog::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) LLU_ERROR("Watchdog is already running.");
+  stopping_ = false;
+  auto now  = Clock::now();
+  for (auto &heartbeat : heartbeats_) heartbeat->last_change_ = now;
+  thread_ = std::thread([this] {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not cv_.wait_for(lock, check_period_, [this] { return stopping_; })) {
+      lock.unlock();
+      check();
+      lock.lock();
+    }
+  });
+}
+
+inline void Watchdog::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+inline std::vector<Overrun> Watchdog::overruns() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {history_.begin(), history_.end()};
+}
+
+inline void Watchdog::check() {
+  std::vector<std::pair<Heartbeat *, Overrun>> missed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    for (std::size_t i{}; i < heartbeats_.size(); ++i) {
+      Heartbeat &heartbeat = *heartbeats_[i];
+      std::uint64_t beats  = heartbeat.beats_.load(std::memory_order_relaxed);
+      if (beats != heartbeat.last_beats_) {
+        heartbeat.last_beats_  = beats;
+        heartbeat.last_change_ = now;
+        heartbeat.stalled_     = false;
+      } else if (not heartbeat.stalled_ and now - heartbeat.last_change_ > heartbeat.deadline_) {
+        heartbeat.stalled_ = true;
+        heartbeat.misses_.fetch_add(1, std::memory_order_relaxed);
+        Overrun overrun{i, now, now - heartbeat.last_change_};
+        history_.push_back(overrun);
+        missed.emplace_back(&heartbeat, overrun);
+      }
+    }
+  }
+  // Call back without the lock, so callbacks may query the watchdog
+  for (auto &[heartbeat, overrun] : missed) {
+    if (heartbeat->callback_) heartbeat->callback_(overrun);
+  }
+}
+}  // namespace llu
+
+#endif  // LLU_WATCHDOG_H_
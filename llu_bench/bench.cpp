@@ -0,0 +1,242 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include <llu/chrono.h>
+#include <llu/eigen.h>
+#include <llu/geometry.h>
+#include <llu/histogram.h>
+#include <llu/math.h>
+#include <llu/squeue.h>
+#include <llu/yaml.h>
+
+#include "bench.h"
+
+namespace {
+constexpr std::size_t kNumInputs = 256;  // power of two, cycled through to defeat constant folding
+constexpr std::size_t kArraySize = 1024;
+
+using llu::bench::doNotOptimize;
+
+void benchQueue(llu::bench::Runner &runner) {
+  llu::StaticQueue<float> queue(kArraySize);
+  llu::StaticQueue<float, true> pow2_queue(kArraySize);
+  float value = 0.f;
+  runner.run("squeue/push_back", [&] {
+    queue.push_back(value += 1.f);
+    doNotOptimize(queue);
+  });
+  runner.run("squeue/push_back_pow2", [&] {
+    pow2_queue.push_back(value += 1.f);
+    doNotOptimize(pow2_queue);
+  });
+  runner.run("squeue/iterate_1024", [&] {
+    float sum = 0.f;
+    for (float item : queue) sum += item;
+    doNotOptimize(sum);
+  });
+}
+
+void benchQuaternion(llu::bench::Runner &runner) {
+  std::mt19937 gen(0);
+  std::normal_distribution<double> dist;
+  std::vector<llu::Quatd> quats;
+  std::vector<Eigen::Quaterniond> eigen_quats;
+  std::vector<llu::Vec3d> vecs;
+  for (std::size_t i{}; i < kNumInputs; ++i) {
+    quats.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+    eigen_quats.emplace_back(quats.back().w(), quats.back().x(), quats.back().y(), quats.back().z());
+    vecs.emplace_back(dist(gen), dist(gen), dist(gen));
+  }
+  std::size_t i = 0;
+  auto next     = [&i] { return i = (i + 1) & (kNumInputs - 1); };
+
+  runner.run("quaternion/multiply/llu", [&] {
+    std::size_t j = next();
+    auto q        = quats[j] * quats[j ^ 1];
+    doNotOptimize(q);
+  });
+  runner.run("quaternion/multiply/eigen", [&] {
+    std::size_t j        = next();
+    Eigen::Quaterniond q = eigen_quats[j] * eigen_quats[j ^ 1];
+    doNotOptimize(q);
+  });
+  runner.run("quaternion/rotate/llu", [&] {
+    std::size_t j = next();
+    llu::Vec3d v  = quats[j] * vecs[j];
+    doNotOptimize(v);
+  });
+  runner.run("quaternion/rotate/eigen", [&] {
+    std::size_t j = next();
+    llu::Vec3d v  = eigen_quats[j] * vecs[j];
+    doNotOptimize(v);
+  });
+  runner.run("quaternion/integrate/llu", [&] {
+    std::size_t j = next();
+    auto q        = quats[j].integrate(vecs[j], 1e-3);
+    doNotOptimize(q);
+  });
+  runner.run("quaternion/slerp/llu", [&] {
+    std::size_t j = next();
+    auto q        = quats[j].slerp(quats[j ^ 1], 0.3);
+    doNotOptimize(q);
+  });
+  runner.run("quaternion/slerp/eigen", [&] {
+    std::size_t j        = next();
+    Eigen::Quaterniond q = eigen_quats[j].slerp(0.3, eigen_quats[j ^ 1]);
+    doNotOptimize(q);
+  });
+  runner.run("quaternion/euler_angles/llu", [&] {
+    llu::Vec3d rpy = quats[next()].eulerAngles();
+    doNotOptimize(rpy);
+  });
+  runner.run("quaternion/euler_angles/eigen", [&] {
+    llu::Vec3d ypr = eigen_quats[next()].toRotationMatrix().eulerAngles(2, 1, 0);
+    doNotOptimize(ypr);
+  });
+
+  std::vector<llu::Quatf> quats_f;
+  std::vector<llu::Vec3f> vecs_f(kArraySize), rotated_f(kArraySize);
+  llu::batch::QuatArray<float> batch_quats(kArraySize, 4);
+  llu::batch::Vec3Array<float> batch_vecs = llu::batch::Vec3Array<float>::Random(kArraySize, 3);
+  llu::batch::Vec3Array<float> batch_rotated(kArraySize, 3);
+  for (std::size_t k{}; k < kArraySize; ++k) {
+    quats_f.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+    batch_quats.row(k) = quats_f.back().coeffs().transpose().array();
+    vecs_f[k]          = batch_vecs.row(k).transpose().matrix();
+  }
+  runner.run("quaternion/rotate_1024/llu_loop", [&] {
+    for (std::size_t k{}; k < kArraySize; ++k) rotated_f[k] = quats_f[k] * vecs_f[k];
+    doNotOptimize(rotated_f);
+  });
+  runner.run("quaternion/rotate_1024/llu_batch", [&] {
+    llu::batch::rotate(batch_quats, batch_vecs, batch_rotated);
+    doNotOptimize(batch_rotated);
+  });
+
+  llu::Transformd transform{quats[0], vecs[0]};
+  Eigen::Isometry3d eigen_transform = Eigen::Translation3d(vecs[0]) * eigen_quats[0];
+  Eigen::Matrix3Xd points = Eigen::Matrix3Xd::Random(3, kArraySize), transformed(3, kArraySize);
+  runner.run("transform/compose/llu", [&] {
+    std::size_t j = next();
+    auto t        = transform * llu::Transformd{quats[j], vecs[j]};
+    doNotOptimize(t);
+  });
+  runner.run("transform/compose/eigen", [&] {
+    std::size_t j       = next();
+    Eigen::Isometry3d t = eigen_transform * (Eigen::Translation3d(vecs[j]) * eigen_quats[j]);
+    doNotOptimize(t);
+  });
+  runner.run("transform/points_1024/llu", [&] {
+    transformed = transform.transformPoints(points);
+    doNotOptimize(transformed);
+  });
+  runner.run("transform/points_1024/eigen", [&] {
+    transformed = eigen_transform * points;
+    doNotOptimize(transformed);
+  });
+}
+
+void benchMath(llu::bench::Runner &runner) {
+  llu::ArrXf input = llu::ArrXf::Random(kArraySize) * 5.f;
+  llu::ArrXf output(kArraySize);
+  runner.run("math/sigmoid_1024", [&] {
+    output = llu::sigmoid(input);
+    doNotOptimize(output);
+  });
+  llu::ArrXf other = llu::ArrXf::Random(kArraySize) * 5.f;
+  runner.run("math/atan2_1024/libm", [&] {
+    output = input.binaryExpr(other, [](float y, float x) { return std::atan2(y, x); });
+    doNotOptimize(output);
+  });
+  runner.run("math/atan2_1024/approx", [&] {
+    output = llu::batch::approxAtan2(input, other);
+    doNotOptimize(output);
+  });
+  runner.run("math/sin_1024/libm", [&] {
+    output = input.unaryExpr([](float x) { return std::sin(x); });
+    doNotOptimize(output);
+  });
+  runner.run("math/sin_1024/approx", [&] {
+    output = llu::batch::approxSin(input);
+    doNotOptimize(output);
+  });
+  runner.run("math/angle_diff_1024/scalar", [&] {
+    for (Eigen::Index k{}; k < input.size(); ++k) output[k] = llu::angleDiff(input[k], other[k]);
+    doNotOptimize(output);
+  });
+  runner.run("math/angle_diff_1024/batch", [&] {
+    output = llu::batch::angleDiff(input, other);
+    doNotOptimize(output);
+  });
+
+  llu::ArrXf data = llu::ArrXf::Random(kArraySize);
+  data[10]        = NAN;
+  data[500]       = INFINITY;
+  runner.run("eigen/get_non_finite_indices_1024", [&] {
+    auto indices = llu::getNonFiniteIndices(data);
+    doNotOptimize(indices);
+  });
+}
+
+void benchYaml(llu::bench::Runner &runner) {
+  YAML::Node node = YAML::Load("{vec: [0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2], vec3: [1, 2, 3]}");
+  std::vector<double> vec(12);
+  llu::VecXd eigen_vec(12);
+  llu::Vec3d vec3;
+  runner.run("yaml/set_to/vector_12", [&] {
+    llu::yml::setTo(node, "vec", vec);
+    doNotOptimize(vec);
+  });
+  runner.run("yaml/set_to/vecxd_12", [&] {
+    llu::yml::setTo(node, "vec", eigen_vec);
+    doNotOptimize(eigen_vec);
+  });
+  runner.run("yaml/set_to/vec3d", [&] {
+    llu::yml::setTo(node, "vec3", vec3);
+    doNotOptimize(vec3);
+  });
+}
+
+void benchRate(llu::bench::Runner &runner) {
+  constexpr std::size_t kNumCycles = 500;
+  llu::Rate rate(1000);
+  llu::Histogram jitter;
+  for (std::size_t i{}; i < kNumCycles; ++i) {
+    rate.sleep();
+    jitter.record(rate.jitter());
+  }
+  auto add = [&](const char *name, double value) { runner.add({name, "ns", value, value, kNumCycles}); };
+  add("rate/sleep_jitter_p50", static_cast<double>(jitter.percentile(50.)));
+  add("rate/sleep_jitter_p99", static_cast<double>(jitter.percentile(99.)));
+  add("rate/sleep_jitter_max", static_cast<double>(jitter.max()));
+  auto overruns = static_cast<double>(rate.overruns());
+  runner.add({"rate/overruns", "count", overruns, overruns, kNumCycles});
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *json_path = nullptr;
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--json") == 0 and i + 1 < argc) json_path = argv[++i];
+  }
+  llu::bench::pinOrWarn(0);
+
+  llu::bench::Runner runner;
+  benchQueue(runner);
+  benchQuaternion(runner);
+  benchMath(runner);
+  benchYaml(runner);
+  benchRate(runner);
+
+  if (json_path) {
+    std::FILE *file = std::fopen(json_path, "w");
+    if (not file) LLU_ERROR("Failed to open '{}' for writing.", json_path);
+    runner.writeJson(file);
+    std::fclose(file);
+  }
+}
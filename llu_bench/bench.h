@@ -0,0 +1,101 @@
+#ifndef LLU_BENCH_BENCH_H_
+#define LLU_BENCH_BENCH_H_
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <llu/chrono.h>
+#include <llu/error.h>
+#include <llu/executor.h>
+
+namespace llu {
+namespace bench {
+/**
+ * @brief Backs off inside a busy-wait loop, yields the CPU if there is no other core to make progress on.
+ */
+inline void relax() {
+  static const bool single_core = std::thread::hardware_concurrency() < 2;
+  if (single_core) std::this_thread::yield();
+}
+
+inline void pinOrWarn(int cpu) {
+  if (not pinThread(cpu)) LLU_WARN("Failed to pin thread to CPU {}, results may be noisy.", cpu);
+}
+
+// Keeps the compiler from optimizing away the computation of `value`
+template <typename T>
+inline void doNotOptimize(T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Result {
+  std::string name, unit;
+  double value, min;
+  std::size_t iterations;
+};
+
+/**
+ * @brief Runs timed cases and collects their results for printing and JSON export.
+ *
+ * A case is called in batches sized to take about 1 ms, then timed over `kNumSamples` samples of about `kSampleTime`
+ * each. The median and the minimum time per call are reported.
+ */
+class Runner {
+ public:
+  static constexpr int kNumSamples     = 7;
+  static constexpr auto kSampleTime    = std::chrono::milliseconds(20);
+  static constexpr auto kCalibrateTime = std::chrono::milliseconds(1);
+
+  template <typename Func>
+  void run(const std::string &name, Func &&func);
+  void add(Result result) {
+    LLU_PRINT("{:<40} {:>12.2f} {:<6} (min {:.2f}, {} iterations)", result.name, result.value, result.unit,
+              result.min, result.iterations);
+    results_.push_back(std::move(result));
+  }
+
+  [[nodiscard]] const std::vector<Result> &results() const { return results_; }
+  void writeJson(std::FILE *file) const;
+
+ private:
+  std::vector<Result> results_;
+};
+
+template <typename Func>
+void Runner::run(const std::string &name, Func &&func) {
+  auto time = [&func](std::size_t num) {
+    auto start = Clock::now();
+    for (std::size_t i{}; i < num; ++i) func();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  };
+  std::size_t batch = 1;
+  while (time(batch) < std::chrono::duration<double, std::nano>(kCalibrateTime).count()) batch *= 2;
+  std::size_t num = batch * static_cast<std::size_t>(kSampleTime / kCalibrateTime);
+  std::vector<double> samples;
+  for (int i{}; i < kNumSamples; ++i) samples.push_back(time(num) / static_cast<double>(num));
+  std::sort(samples.begin(), samples.end());
+  add({name, "ns", samples[samples.size() / 2], samples.front(), num * kNumSamples});
+}
+
+inline void Runner::writeJson(std::FILE *file) const {
+  fmt::print(file, R"({{
+  "context": {{"compiler": "{}", "num_cpus": {}}},
+  "results": [)",
+             __VERSION__, std::thread::hardware_concurrency());
+  for (std::size_t i{}; i < results_.size(); ++i) {
+    const Result &r = results_[i];
+    fmt::print(file, R"({}
+    {{"name": "{}", "unit": "{}", "value": {}, "min": {}, "iterations": {}}})",
+               i == 0 ? "" : ",", r.name, r.unit, r.value, r.min, r.iterations);
+  }
+  fmt::print(file, "\n  ]\n}}\n");
+}
+}  // namespace bench
+}  // namespace llu
+
+#endif  // LLU_BENCH_BENCH_H_
@@ -0,0 +1,99 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <llu/chrono.h>
+#include <llu/latest.h>
+
+#include "bench.h"
+
+namespace {
+constexpr auto kDuration = std::chrono::milliseconds(200);
+
+// Base orientation, base position and joint states of a quadruped
+struct RobotState {
+  float quat[4];
+  float pos[3];
+  float joint_pos[12];
+  float joint_vel[12];
+};
+
+RobotState makeState(float value) {
+  RobotState state{};
+  state.quat[0]      = value;
+  state.joint_vel[0] = value;
+  return state;
+}
+
+class MutexValue {
+ public:
+  void store(const RobotState &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value_ = value;
+  }
+  RobotState load() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return value_;
+  }
+
+ private:
+  std::mutex mutex_;
+  RobotState value_{};
+};
+
+class TripleValue {
+ public:
+  void store(const RobotState &value) { buffer_.write(value); }
+  RobotState load() { return buffer_.read(); }
+
+ private:
+  llu::TripleBuffer<RobotState> buffer_;
+};
+
+template <typename Value>
+void bench(const char *name, int num_readers) {
+  Value value;
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> total_reads{0};
+  std::vector<std::thread> readers;
+  for (int i{}; i < num_readers; ++i) {
+    readers.emplace_back([&, i] {
+      llu::bench::pinOrWarn(i + 1);
+      std::size_t reads = 0;
+      float checksum    = 0.f;
+      while (not done.load(std::memory_order_relaxed)) {
+        RobotState state = value.load();
+        checksum += state.quat[0] - state.joint_vel[0];
+        ++reads;
+        llu::bench::relax();
+      }
+      if (checksum != 0.f) LLU_CRIT("{}: inconsistent snapshot detected.", name);
+      total_reads += reads;
+    });
+  }
+
+  llu::bench::pinOrWarn(0);
+  std::size_t writes = 0;
+  auto start         = llu::Clock::now();
+  while (llu::Clock::now() - start < kDuration) {
+    value.store(makeState(static_cast<float>(writes++)));
+    llu::bench::relax();
+  }
+  done = true;
+  for (auto &reader : readers) reader.join();
+  double seconds = std::chrono::duration<double>(llu::Clock::now() - start).count();
+  LLU_PRINT("{:<12} readers: {}  writes: {:8.2f} M/s  reads: {:8.2f} M/s per reader", name, num_readers,
+            writes / seconds / 1e6, total_reads / seconds / 1e6 / num_readers);
+}
+}  // namespace
+
+int main() {
+  if (std::thread::hardware_concurrency() < 2) LLU_WARN("Less than two CPUs available, threads will share a core.");
+  // The triple buffer supports a single reader only
+  bench<TripleValue>("TripleBuffer", 1);
+  for (int num_readers{1}; num_readers <= 4; ++num_readers) {
+    bench<llu::LatestValue<RobotState>>("LatestValue", num_readers);
+    bench<MutexValue>("Mutex", num_readers);
+  }
+}
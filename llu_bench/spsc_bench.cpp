@@ -0,0 +1,91 @@
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <llu/chrono.h>
+#include <llu/spsc.h>
+
+#include "bench.h"
+
+namespace {
+constexpr int kCapacity = 1024;
+constexpr int kNumItems = 2000000;
+constexpr int kNumTrips = 100000;
+
+class MutexQueue {
+ public:
+  bool try_push(int item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() == kCapacity) return false;
+    queue_.push_back(item);
+    return true;
+  }
+
+  bool try_pop(int &item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) return false;
+    item = queue_.front();
+    queue_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<int> queue_;
+};
+
+template <typename Queue>
+void benchThroughput(const char *name, int num_items) {
+  Queue queue;
+  std::thread consumer([&queue, num_items] {
+    llu::bench::pinOrWarn(1);
+    int item;
+    for (int i{}; i < num_items; ++i) {
+      while (not queue.try_pop(item)) llu::bench::relax();
+    }
+  });
+  llu::bench::pinOrWarn(0);
+  auto start = llu::Clock::now();
+  for (int i{}; i < num_items; ++i) {
+    while (not queue.try_push(i)) llu::bench::relax();
+  }
+  consumer.join();
+  double seconds = std::chrono::duration<double>(llu::Clock::now() - start).count();
+  LLU_PRINT("{:<12} throughput: {:8.2f} Mops/s", name, num_items / seconds / 1e6);
+}
+
+template <typename Queue>
+void benchRoundTrip(const char *name, int num_trips) {
+  Queue ping, pong;
+  std::thread echo([&ping, &pong, num_trips] {
+    llu::bench::pinOrWarn(1);
+    int item;
+    for (int i{}; i < num_trips; ++i) {
+      while (not ping.try_pop(item)) llu::bench::relax();
+      while (not pong.try_push(item)) llu::bench::relax();
+    }
+  });
+  llu::bench::pinOrWarn(0);
+  auto start = llu::Clock::now();
+  int item;
+  for (int i{}; i < num_trips; ++i) {
+    while (not ping.try_push(i)) llu::bench::relax();
+    while (not pong.try_pop(item)) llu::bench::relax();
+  }
+  echo.join();
+  auto elapsed = llu::Clock::now() - start;
+  LLU_PRINT("{:<12} round trip: {:8} ns", name, llu::duration_cast<llu::NSec>(elapsed).count() / num_trips);
+}
+
+struct Spsc : llu::SpscQueue<int> {
+  Spsc() : llu::SpscQueue<int>(kCapacity) {}
+};
+}  // namespace
+
+int main() {
+  if (std::thread::hardware_concurrency() < 2) LLU_WARN("Less than two CPUs available, threads will share a core.");
+  benchThroughput<Spsc>("SpscQueue", kNumItems);
+  benchThroughput<MutexQueue>("MutexQueue", kNumItems / 10);
+  benchRoundTrip<Spsc>("SpscQueue", kNumTrips);
+  benchRoundTrip<MutexQueue>("MutexQueue", kNumTrips / 10);
+}
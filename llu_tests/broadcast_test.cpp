@@ -0,0 +1,71 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <llu/broadcast.h>
+
+namespace {
+struct Frame {
+  int index;
+  float data[3];
+};
+}  // namespace
+
+TEST(LLU_BROADCAST_TEST, LLU_BROADCAST_DATA_TEST) {
+  llu::BroadcastQueue<Frame> q(4);
+  ASSERT_EQ(q.capacity(), 4) << "Capacity should be 4";
+  auto r1 = q.subscribe();
+  auto r2 = q.subscribe();
+  Frame frame{};
+  ASSERT_FALSE(r1.try_pop(frame)) << "Pop should fail without new items";
+
+  for (int i{}; i < 3; ++i) q.push_back(Frame{i, {1.f * i, 2.f * i, 3.f * i}});
+  ASSERT_EQ(r1.available(), 3) << "Reader should have 3 items available";
+  for (int i{}; i < 3; ++i) {
+    ASSERT_TRUE(r1.try_pop(frame)) << "Pop should succeed";
+    ASSERT_EQ(frame.index, i) << "Items should be read in order";
+    ASSERT_EQ(frame.data[2], 3.f * i) << "Item data should be preserved";
+  }
+  ASSERT_FALSE(r1.try_pop(frame)) << "Pop should fail without new items";
+  ASSERT_EQ(r1.dropped(), 0) << "Reader should not drop items";
+
+  for (int i{3}; i < 10; ++i) q.emplace_back(Frame{i, {}});
+  ASSERT_TRUE(r2.try_pop(frame)) << "Pop should succeed";
+  ASSERT_EQ(frame.index, 7) << "Lagging reader should skip to the oldest valid item";
+  ASSERT_EQ(r2.dropped(), 7) << "Lagging reader should report dropped items";
+  ASSERT_TRUE(r1.try_pop(frame)) << "Pop should succeed";
+  ASSERT_EQ(frame.index, 7) << "Lagging reader should skip to the oldest valid item";
+  ASSERT_EQ(r1.dropped(), 4) << "Lagging reader should report dropped items";
+
+  auto r3 = q.subscribe();
+  ASSERT_FALSE(r3.try_pop(frame)) << "New reader should only receive new items";
+  r2.seek_latest();
+  ASSERT_EQ(r2.available(), 0) << "Reader should have no items after seeking";
+}
+
+TEST(LLU_BROADCAST_TEST, LLU_BROADCAST_THREAD_TEST) {
+  constexpr int kNum = 100000;
+  llu::BroadcastQueue<Frame> q(64);
+  std::vector<std::thread> readers;
+  for (int i{}; i < 3; ++i) {
+    readers.emplace_back([reader = q.subscribe(), kNum]() mutable {
+      Frame frame{};
+      int last = -1;
+      while (last < kNum - 1) {
+        if (not reader.try_pop(frame)) {
+          std::this_thread::yield();
+          continue;
+        }
+        ASSERT_GT(frame.index, last) << "Items should be received in increasing order";
+        ASSERT_EQ(frame.data[0], static_cast<float>(frame.index)) << "Items should not be torn";
+        ASSERT_EQ(frame.data[2], static_cast<float>(frame.index)) << "Items should not be torn";
+        last = frame.index;
+      }
+    });
+  }
+  for (int i{}; i < kNum; ++i) {
+    auto value = static_cast<float>(i);
+    q.push_back(Frame{i, {value, value, value}});
+  }
+  for (auto &reader : readers) reader.join();
+}
@@ -1,3 +1,128 @@
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <llu/chrono.h>
+
+TEST(LLU_CHRONO_TEST, LLU_RATE_TEST) {
+  // The schedule starts at construction
+  auto start = llu::Clock::now();
+  llu::Rate rate(500);
+  std::size_t overran = 0;
+  for (int i{}; i < 10; ++i) overran += rate.sleep() > llu::Duration::zero();
+  ASSERT_GE(llu::Clock::now() - start, llu::MSec(20)) << "10 cycles should take at least 20ms";
+  // An idle cycle only overruns when the thread is preempted past its deadline, allow for a rare scheduler hiccup
+  ASSERT_LE(overran, 2) << "Idle cycles should not overrun";
+  ASSERT_EQ(rate.overruns(), overran) << "Every overrunning cycle should be counted";
+  ASSERT_GE(rate.jitter(), llu::Duration::zero()) << "Sleep should never return before the deadline";
+}
+
+TEST(LLU_CHRONO_TEST, LLU_RATE_OVERRUN_TEST) {
+  for (auto policy : {llu::OverrunPolicy::kCatchUp, llu::OverrunPolicy::kSkip, llu::OverrunPolicy::kRephase}) {
+    llu::Rate rate(100, policy);
+    std::this_thread::sleep_for(llu::MSec(35));
+    auto overrun = rate.sleep();
+    ASSERT_GE(overrun, llu::MSec(25)) << "The first cycle should overrun by at least 25ms";
+    ASSERT_EQ(rate.overruns(), 1) << "One overrun should be counted";
+
+    auto start = llu::Clock::now();
+    rate.sleep();
+    auto waited = llu::Clock::now() - start;
+    if (policy == llu::OverrunPolicy::kCatchUp) {
+      ASSERT_LT(waited, llu::MSec(5)) << "Catch-up should run the missed cycle immediately";
+      ASSERT_EQ(rate.overruns(), 2) << "The missed cycle should be counted";
+    } else if (policy == llu::OverrunPolicy::kSkip) {
+      ASSERT_LT(waited, llu::MSec(10)) << "Skip should keep the phase of the schedule";
+      ASSERT_EQ(rate.overruns(), 1) << "Skipped cycles should not be counted again";
+    } else {
+      ASSERT_GE(waited, llu::MSec(9)) << "Re-phase should restart a full cycle";
+      ASSERT_EQ(rate.overruns(), 1) << "No further overrun should be counted";
+    }
+  }
+}
+
+
+TEST(LLU_CHRONO_TEST, LLU_RATE_CLOCK_TEST) {
+  // Clocks whose epoch is not the one of CLOCK_MONOTONIC sleep for the time left
+  auto start = llu::Clock::now();
+  llu::BasicRate<std::chrono::system_clock> system_rate(500);
+  for (int i{}; i < 5; ++i) system_rate.sleep();
+  llu::BasicRate<llu::TscClock> tsc_rate(500);
+  for (int i{}; i < 5; ++i) tsc_rate.sleep();
+  auto elapsed = llu::Clock::now() - start;
+  ASSERT_GE(elapsed, llu::MSec(20)) << "10 cycles should take at least 20ms";
+  ASSERT_LT(elapsed, llu::MSec(500)) << "Rates of other clocks should wake up on time";
+}
+
+TEST(LLU_CHRONO_TEST, LLU_TIMER_HISTOGRAM_TEST) {
+  llu::Histogram hist;
+  llu::Timer timer;
+  timer.attach(&hist);
+  for (int i{}; i < 5; ++i) {
+    llu::TimerContext ctx(timer);
+    std::this_thread::sleep_for(llu::USec(100));
+  }
+  ASSERT_EQ(hist.count(), 5) << "Every timed scope should be recorded";
+  ASSERT_GE(hist.min(), 100000) << "Each scope should take at least 100us";
+  timer.attach(nullptr);
+  { llu::TimerContext ctx(timer); }
+  ASSERT_EQ(hist.count(), 5) << "A detached histogram should not be recorded";
+
+  llu::Histogram intervals;
+  llu::IntervalStats<> stats;
+  stats.attach(&intervals);
+  for (int i{}; i < 4; ++i) stats.tick();
+  ASSERT_EQ(intervals.count(), 3) << "Every interval should be recorded";
+}
+
+TEST(LLU_CHRONO_TEST, LLU_TSC_CLOCK_TEST) {
+  bool usable = llu::TscClock::usable();
+  auto start  = llu::TscClock::now();
+  std::this_thread::sleep_for(llu::MSec(20));
+  auto elapsed = llu::timePassed<llu::USec>(start);
+  ASSERT_GE(elapsed, 19000) << "TSC clock should measure a 20ms sleep, usable: " << usable;
+  ASSERT_LT(elapsed, 40000) << "TSC clock should measure a 20ms sleep, usable: " << usable;
+
+  llu::TscTimer timer;
+  auto last = llu::TscClock::now();
+  for (int i{}; i < 1000; ++i) {
+    llu::TimerContext ctx(timer);
+    auto now = llu::TscClock::now();
+    ASSERT_GE(now, last) << "TSC clock should be monotonic";
+    last = now;
+  }
+  ASSERT_EQ(timer.count(), 1000) << "TSC timer should count every scope";
+
+  llu::IntervalStats<llu::USec, llu::TscClock> stats;
+  for (int i{}; i < 3; ++i) stats.tick();
+  ASSERT_EQ(stats.count(), 2) << "Interval stats should accept the TSC clock";
+}
+
+TEST(LLU_CHRONO_TEST, LLU_VIRTUAL_CLOCK_TEST) {
+  using VClock = llu::VirtualClock;
+  VClock::set(VClock::time_point{});
+  llu::BasicRate<VClock> rate(1000);
+  llu::BasicTimer<VClock> timer;
+  std::atomic<int> cycles{0};
+  std::thread loop([&] {
+    for (int i{}; i < 100; ++i) {
+      llu::TimerContext ctx(timer);
+      rate.sleep();
+      ++cycles;
+    }
+  });
+
+  // Step time in lockstep with the loop, far faster than real time. Each step waits for the previous one to complete
+  // its cycle and block again, a sleeper that was woken but has not yet left `sleepUntil()` still counts as sleeping.
+  auto start = llu::Clock::now();
+  for (int i{}; i < 100; ++i) {
+    while (cycles < i or VClock::sleepers() != 1) std::this_thread::yield();
+    VClock::advance(llu::MSec(1));
+  }
+  loop.join();
+  ASSERT_LT(llu::Clock::now() - start, llu::MSec(100)) << "100 simulated milliseconds should run faster";
+  ASSERT_EQ(VClock::now().time_since_epoch(), llu::MSec(100)) << "Simulated time should have advanced 100ms";
+  ASSERT_EQ(rate.overruns(), 0) << "No cycle should overrun in lockstep";
+  ASSERT_EQ(timer.total(), llu::MSec(100)) << "Timer should measure simulated time";
+  ASSERT_EQ(llu::timePassed<llu::MSec>(VClock::time_point{}), 100) << "timePassed should use the virtual clock";
+}
@@ -54,3 +54,34 @@ TEST(LLU_EIGEN_TEST, GetNonFiniteIndices) {
   EXPECT_EQ(indices_mat_mixed[0], 4);
   EXPECT_EQ(indices_mat_mixed[1], 6);
 }
+
+TEST(LLU_EIGEN_TEST, HistoryMatrix) {
+  llu::HistoryMatrix<float> oldest_first(2, 3);
+  llu::HistoryMatrix<float> newest_first(2, 3, llu::HistoryOrder::kNewestFirst);
+  oldest_first.push_back(llu::Vec2f{0.f, 0.f});
+  newest_first.push_back(llu::Vec2f{0.f, 0.f});
+  ASSERT_EQ(oldest_first.size(), 1);
+  EXPECT_TRUE(oldest_first.flatten().isZero()) << "First frame should pad the history";
+
+  for (int i{1}; i < 5; ++i) {
+    llu::Vec2f frame{static_cast<float>(i), static_cast<float>(-i)};
+    oldest_first.push_back(frame);
+    newest_first.push_back(frame);
+    EXPECT_TRUE(oldest_first.newest().isApprox(frame));
+    EXPECT_TRUE(newest_first.newest().isApprox(frame));
+  }
+  ASSERT_EQ(oldest_first.size(), 3);
+  llu::VecXf expected(6);
+  expected << 2.f, -2.f, 3.f, -3.f, 4.f, -4.f;
+  EXPECT_TRUE(oldest_first.flatten().isApprox(expected));
+  expected << 4.f, -4.f, 3.f, -3.f, 2.f, -2.f;
+  EXPECT_TRUE(newest_first.flatten().isApprox(expected));
+  EXPECT_EQ(oldest_first.matrix().cols(), 3);
+  EXPECT_EQ(oldest_first.matrix()(0, 2), 4.f);
+  EXPECT_EQ(newest_first.matrix()(1, 2), -2.f);
+
+  oldest_first.fill(llu::Vec2f::Ones());
+  EXPECT_TRUE(oldest_first.matrix().isOnes());
+  oldest_first.clear();
+  EXPECT_TRUE(oldest_first.is_empty());
+}
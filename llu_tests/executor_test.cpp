@@ -0,0 +1,73 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/executor.h>
+
+TEST(LLU_EXECUTOR_TEST, LLU_EXECUTOR_RATE_TEST) {
+  llu::Executor executor(1000, 2);
+  std::atomic<std::int64_t> fast_runs{0}, mid_runs{0}, slow_runs{0};
+  executor.addTask("control", 1000, [&] { ++fast_runs; });
+  executor.addTask("estimation", 500, [&] { ++mid_runs; }, {1, 0});
+  executor.addTask("planning", 50, [&] { ++slow_runs; }, {0, 1});
+  executor.setThreadOptions(1, {0, 10});  // falls back without privileges
+  try {
+    executor.addTask("invalid", 300, [] {});
+    ASSERT_TRUE(false) << "Non-harmonic rate should throw";
+  } catch (std::runtime_error &e) {}
+  try {
+    executor.addTask("invalid", 500, [] {}, {2, 0});
+    ASSERT_TRUE(false) << "Phase beyond the period should throw";
+  } catch (std::runtime_error &e) {}
+
+  executor.start();
+  ASSERT_TRUE(executor.is_running()) << "Executor should be running";
+  std::this_thread::sleep_for(llu::MSec(200));
+  executor.stop();
+  ASSERT_FALSE(executor.is_running()) << "Executor should be stopped";
+
+  for (std::size_t i{}; i < executor.numTasks(); ++i) {
+    const auto &stats = executor.stats(i);
+    ASSERT_EQ(stats.runs, stats.latency.count()) << "Every run should record its latency";
+    ASSERT_LE(stats.latency.max(), stats.response.max()) << "Response should include the latency";
+  }
+  // Every release is either run or skipped
+  auto releases = [&](std::size_t i) { return executor.stats(i).runs + executor.stats(i).skipped; };
+  ASSERT_GE(fast_runs, 150) << "Control should run at about 1 kHz";
+  ASSERT_NEAR(static_cast<double>(releases(1)), releases(0) / 2., 2.) << "Estimation should run at half the rate";
+  ASSERT_NEAR(static_cast<double>(releases(2)), releases(0) / 20., 2.) << "Planning should run at 50 Hz";
+  ASSERT_EQ(executor.stats(0).runs, static_cast<std::size_t>(fast_runs)) << "Stats should count every run";
+  ASSERT_EQ(executor.stats(1).runs, static_cast<std::size_t>(mid_runs)) << "Stats should count every run";
+  ASSERT_EQ(executor.stats(2).runs, static_cast<std::size_t>(slow_runs)) << "Stats should count every run";
+  // Every wakeup of a thread releases its fastest task
+  ASSERT_EQ(executor.wakeups(0), executor.stats(0).runs) << "The control thread should wake up at 1 kHz";
+  ASSERT_EQ(executor.wakeups(1), executor.stats(2).runs) << "The planning thread should only wake up at 50 Hz";
+}
+
+TEST(LLU_EXECUTOR_TEST, LLU_EXECUTOR_STEP_TEST) {
+  // Periods of 10 and 4 ticks with phases 2 and 0 only release on even ticks
+  llu::Executor executor(1000);
+  executor.addTask("slow", 100, [] {}, {2, 0});
+  executor.addTask("fast", 250, [] {});
+  executor.start();
+  std::this_thread::sleep_for(llu::MSec(100));
+  executor.stop();
+  auto releases = [&](std::size_t i) { return executor.stats(i).runs + executor.stats(i).skipped; };
+  ASSERT_NEAR(static_cast<double>(releases(1)), releases(0) * 2.5, 3.) << "Fast task should run at 250 Hz";
+  ASSERT_LE(executor.wakeups(0), (releases(0) + 1) * 5) << "Thread should only wake up on even ticks";
+  ASSERT_GE(executor.wakeups(0), executor.stats(1).runs) << "Thread should wake up for every run";
+}
+
+TEST(LLU_EXECUTOR_TEST, LLU_EXECUTOR_MISS_TEST) {
+  llu::Executor executor(1000);
+  executor.addTask("slow", 500, [] { std::this_thread::sleep_for(llu::MSec(3)); });
+  executor.start();
+  std::this_thread::sleep_for(llu::MSec(50));
+  executor.stop();
+  const auto &stats = executor.stats(0);
+  ASSERT_GT(stats.runs, 0) << "Slow task should run";
+  ASSERT_GE(stats.misses, stats.runs) << "Every run of the slow task should miss its deadline";
+  ASSERT_GE(stats.response.min(), 3000000) << "Response should cover the run time";
+}
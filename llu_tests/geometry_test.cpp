@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include <Eigen/Geometry>
 
 #include <llu/const.h>
@@ -58,3 +61,172 @@ TEST(LLU_GEOMETRY_TEST, LLU_QUATERNION_TEST) {
   ASSERT_NEAR(q03.y(), q00_coeffs[2], llu::kEPS) << "Quaternions should be equal";
   ASSERT_NEAR(q03.z(), q00_coeffs[3], llu::kEPS) << "Quaternions should be equal";
 }
+
+TEST(LLU_GEOMETRY_TEST, LLU_QUATERNION_SLERP_TEST) {
+  auto q0 = Eigen::Quaterniond(0.1, 0.2, 0.3, 0.4).normalized();
+  auto q1 = Eigen::Quaterniond(-0.9, 0.3, -0.0, 0.1).normalized();
+  for (double t : {0., 0.25, 0.5, 1.}) {
+    ASSERT_TRUE(llu::Quatd(q0).slerp(llu::Quatd(q1), t).isApprox(llu::Quatd(q0.slerp(t, q1)), 1e-9))
+        << "Quaternion slerp failed";
+  }
+  ASSERT_TRUE(llu::Quatd(q0).slerp(llu::Quatd(q0), 0.5).isApprox(llu::Quatd(q0), 1e-9)) << "Quaternion slerp failed";
+}
+
+TEST(LLU_GEOMETRY_TEST, LLU_TRANSFORM_TEST) {
+  auto q0 = Eigen::Quaterniond(0.1, 0.2, 0.3, 0.4).normalized();
+  auto q1 = Eigen::Quaterniond(-0.9, 0.3, -0.0, 0.1).normalized();
+  llu::Vec3d t0{1., -2., 3.}, t1{-0.5, 0.2, 0.7};
+  Eigen::Isometry3d e0 = Eigen::Translation3d(t0) * q0, e1 = Eigen::Translation3d(t1) * q1;
+  llu::Transformd p0{llu::Quatd(q0), t0}, p1{llu::Quatd(q1), t1};
+  ASSERT_TRUE(p0.matrix().isApprox(e0.matrix(), llu::kEPS)) << "Transform to matrix conversion failed";
+
+  auto fromEigen = [](const Eigen::Isometry3d &e) {
+    return llu::Transformd{llu::Quatd(Eigen::Quaterniond(e.rotation())), e.translation()};
+  };
+  ASSERT_TRUE((p0 * p1).isApprox(fromEigen(e0 * e1), llu::kEPS)) << "Transform composition failed";
+  ASSERT_TRUE(p0.inverse().isApprox(fromEigen(e0.inverse()), llu::kEPS)) << "Transform inverse failed";
+  ASSERT_TRUE((p0 * p0.inverse()).isApprox(llu::Transformd{}, llu::kEPS)) << "Transform inverse failed";
+  ASSERT_TRUE(p0.relative(p1).isApprox(fromEigen(e0.inverse() * e1), llu::kEPS)) << "Relative transform failed";
+  ASSERT_TRUE(p0.relative(p0).isApprox(llu::Transformd{}, llu::kEPS)) << "Relative transform failed";
+  ASSERT_TRUE((p0 * p0.relative(p1)).isApprox(p1, llu::kEPS)) << "Relative transform failed";
+
+  llu::Vec3d v{1., 2., 3.};
+  ASSERT_TRUE((p0 * v).isApprox(e0 * v, llu::kEPS)) << "Point transform failed";
+  Eigen::Matrix3Xd points = Eigen::Matrix3Xd::Random(3, 17);
+  Eigen::Matrix3Xd transformed = p0.transformPoints(points);
+  for (Eigen::Index i{}; i < points.cols(); ++i) {
+    ASSERT_TRUE(transformed.col(i).isApprox(e0 * points.col(i), llu::kEPS)) << "Batch point transform failed";
+  }
+  p0.setIdentity();
+  ASSERT_TRUE(p0.transformPoints(points).isApprox(points, llu::kEPS)) << "Identity transform failed";
+}
+
+TEST(LLU_GEOMETRY_TEST, LLU_QUATERNION_BATCH_TEST) {
+  // Not a multiple of the packet size, to cover the scalar tail
+  constexpr Eigen::Index kSize = 37;
+  llu::batch::QuatArray<double> qa(kSize, 4), qb(kSize, 4);
+  llu::batch::Vec3Array<double> v = llu::batch::Vec3Array<double>::Random(kSize, 3);
+  std::vector<llu::Quatd> qa_vec, qb_vec;
+  for (Eigen::Index i{}; i < kSize; ++i) {
+    qa_vec.emplace_back(Eigen::Quaterniond::UnitRandom());
+    qb_vec.emplace_back(Eigen::Quaterniond::UnitRandom());
+    qa.row(i) = qa_vec.back().coeffs().transpose().array();
+    qb.row(i) = qb_vec.back().coeffs().transpose().array();
+  }
+
+  llu::batch::QuatArray<double> qc;
+  llu::batch::Vec3Array<double> rotated, inv_rotated, rpy, rpy_from_mats, approx_rpy, approx_rpy_from_mats;
+  llu::batch::Mat3Array<double> mats;
+  llu::batch::multiply(qa, qb, qc);
+  llu::batch::rotate(qa, v, rotated);
+  llu::batch::inverseRotate(qa, v, inv_rotated);
+  llu::batch::matrix(qa, mats);
+  llu::batch::eulerAngles(qa, rpy);
+  llu::batch::mat2rpy(mats, rpy_from_mats);
+  llu::batch::approxEulerAngles(qa, approx_rpy);
+  llu::batch::approxMat2rpy(mats, approx_rpy_from_mats);
+  ASSERT_EQ(qc.rows(), kSize) << "Batch output should be resized";
+  for (Eigen::Index i{}; i < kSize; ++i) {
+    const llu::Quatd &q = qa_vec[i];
+    llu::Vec3d vi       = v.row(i).transpose().matrix();
+    ASSERT_TRUE((q * qb_vec[i]).coeffs().isApprox(qc.row(i).transpose().matrix(), 1e-12))
+        << "Batch quaternion multiplication failed";
+    ASSERT_TRUE((q * vi).isApprox(rotated.row(i).transpose().matrix(), 1e-12)) << "Batch quaternion rotation failed";
+    ASSERT_TRUE((q.inverse() * vi).isApprox(inv_rotated.row(i).transpose().matrix(), 1e-12))
+        << "Batch quaternion inverse rotation failed";
+    llu::Mat3d mat = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(mats.row(i).eval().data());
+    ASSERT_TRUE(q.matrix().isApprox(mat, 1e-12)) << "Batch quaternion to rotation matrix conversion failed";
+    ASSERT_TRUE(q.eulerAngles().isApprox(rpy.row(i).transpose().matrix(), 1e-9))
+        << "Batch quaternion to Euler angles conversion failed";
+    ASSERT_TRUE(llu::mat2rpy(mat).isApprox(rpy_from_mats.row(i).transpose().matrix(), 1e-9))
+        << "Batch rotation matrix to Euler angles conversion failed";
+    ASSERT_TRUE((q.eulerAngles() - approx_rpy.row(i).transpose().matrix()).isZero(1e-7))
+        << "Approximate batch quaternion to Euler angles conversion failed";
+    ASSERT_TRUE((llu::mat2rpy(mat) - approx_rpy_from_mats.row(i).transpose().matrix()).isZero(1e-7))
+        << "Approximate batch rotation matrix to Euler angles conversion failed";
+  }
+
+  // Single precision over mapped buffers
+  std::vector<float> q_buffer(kSize * 4), v_buffer(kSize * 3), out_buffer(kSize * 3);
+  Eigen::Map<llu::batch::QuatArray<float>> qf(q_buffer.data(), kSize, 4);
+  Eigen::Map<llu::batch::Vec3Array<float>> vf(v_buffer.data(), kSize, 3);
+  qf = qa.cast<float>();
+  vf = v.cast<float>();
+  llu::batch::rotate(qf, vf, Eigen::Map<llu::batch::Vec3Array<float>>(out_buffer.data(), kSize, 3));
+  for (Eigen::Index i{}; i < kSize; ++i) {
+    for (Eigen::Index j{}; j < 3; ++j) {
+      ASSERT_NEAR(out_buffer[j * kSize + i], rotated(i, j), 1e-5) << "Batch quaternion rotation failed";
+    }
+  }
+}
+
+TEST(LLU_GEOMETRY_TEST, LLU_QUATERNION_LIE_TEST) {
+  // Small angles take the series, large ones the trigonometric functions, including just below the series bounds of
+  // double (exp, log) and float (exp, log)
+  for (double angle : {0., 1e-9, 1e-5, 1e-3, 1e-2, 0.1, 1., 3., std::sqrt(1.49e-4), 2 * std::atan(std::sqrt(7.9e-6)),
+                       std::sqrt(0.119), 2 * std::atan(std::sqrt(5.9e-3))}) {
+    llu::Vec3d axis = llu::Vec3d(0.3, -0.5, 0.8).normalized();
+    llu::Quatd q    = llu::Quatd::exp(angle * axis);
+    ASSERT_TRUE(q.isApprox(llu::Quatd(Eigen::Quaterniond(Eigen::AngleAxisd(angle, axis))), 1e-15))
+        << "Quaternion exp failed";
+    ASSERT_TRUE((q.log() - angle * axis).isZero(1e-15)) << "Quaternion log failed";
+    ASSERT_TRUE((llu::Quatd(-q.w(), -q.x(), -q.y(), -q.z()).log() - angle * axis).isZero(1e-15))
+        << "Quaternion log should take the shorter rotation";
+    llu::Quatf qf = llu::Quatf::exp((angle * axis).cast<float>());
+    ASSERT_TRUE(qf.isApprox(llu::Quatf(Eigen::Quaternionf(Eigen::AngleAxisf(angle, axis.cast<float>()))), 1e-6f))
+        << "Quaternion exp failed";
+    ASSERT_TRUE((qf.log() - (angle * axis).cast<float>()).isZero(1e-6f)) << "Quaternion log failed";
+  }
+
+  llu::Quatd q0(0.1, 0.2, 0.3, 0.4), q1(-0.9, 0.3, -0.0, 0.1);
+  llu::Vec3d delta{0.01, -0.02, 0.03};
+  ASSERT_TRUE(q0.boxplus(delta).isApprox(q0 * llu::Quatd::exp(delta), llu::kEPS)) << "Quaternion boxplus failed";
+  ASSERT_TRUE((q0.boxplus(delta).boxminus(q0) - delta).isZero(1e-12)) << "Quaternion boxminus failed";
+  ASSERT_TRUE(q0.boxplus(q1.boxminus(q0)).isApprox(q1, 1e-12)) << "Quaternion boxminus failed";
+
+  // Constant rate about a fixed axis, integrated in 1 ms steps
+  llu::Vec3d omega{0.5, -1., 2.};
+  llu::Quatd q = q0;
+  for (int i{}; i < 1000; ++i) q = q.integrate(omega, 1e-3);
+  ASSERT_TRUE(q.isApprox(q0 * llu::Quatd::exp(omega), 1e-12)) << "Quaternion integration failed";
+  // One hour at 4 kHz in single precision should stay on the unit sphere
+  llu::Quatf qf(q0.coeffs().cast<float>());
+  llu::Vec3f omega_f = omega.cast<float>();
+  for (int i{}; i < 3600 * 4000; ++i) qf = qf.integrate(omega_f, 2.5e-4f);
+  ASSERT_NEAR(qf.coeffs().norm(), 1.f, 1e-5f) << "Long quaternion integration should not drift off the unit sphere";
+  ASSERT_NEAR((qf * llu::Vec3f::UnitX()).norm(), 1.f, 1e-5f) << "Long quaternion integration should not scale vectors";
+
+  // Slerp of small angles falls back to nlerp, up to 1 - cos(angle / 2) = 1e-10, where 1 - cos(angle / 2) = 1e-8
+  // would already be off by 4e-14
+  auto e0 = Eigen::Quaterniond(0.1, 0.2, 0.3, 0.4).normalized();
+  auto angle_of = [](double one_minus_cos) { return 4 * std::asin(std::sqrt(one_minus_cos / 2)); };
+  for (double angle : {1e-9, angle_of(0.98e-10), 1e-5, angle_of(0.98e-8), 1e-3}) {
+    auto e1 = e0 * Eigen::Quaterniond(Eigen::AngleAxisd(angle, llu::Vec3d::UnitZ()));
+    for (double t : {0.25, 0.5, 0.75}) {
+      ASSERT_TRUE(llu::Quatd(e0).slerp(llu::Quatd(e1), t).isApprox(llu::Quatd(e0.slerp(t, e1)), 1e-15))
+          << "Quaternion slerp of small angles failed";
+    }
+  }
+}
+
+TEST(LLU_GEOMETRY_TEST, LLU_QUATERNION_UNCHECKED_TEST) {
+  // Mounting frames composed at compile time
+  constexpr llu::Quatd kYaw90   = llu::Quatd::unchecked(M_SQRT1_2, 0., 0., M_SQRT1_2);
+  constexpr llu::Quatd kYaw180  = kYaw90 * kYaw90;
+  constexpr llu::Quatd kYawBack = kYaw180 * kYaw90.inverse();
+  static_assert(kYaw180.w() < 1e-15 and kYaw180.z() > 1 - 1e-15, "Constexpr composition failed");
+  static_assert(kYawBack.dot(kYaw90) > 1 - 1e-15, "Constexpr inverse failed");
+  ASSERT_TRUE(kYaw180.isApprox(llu::Quatd::fromYaw(M_PI), llu::kEPS)) << "Constexpr composition failed";
+
+  auto q = llu::Quatd::unchecked(2., 0., 0., 0.);
+  ASSERT_EQ(q.w(), 2.) << "Unchecked construction should not normalize";
+  ASSERT_EQ(q.normalized().w(), 1.) << "Normalized quaternion should have unit norm";
+  ASSERT_EQ(llu::Quatd(2., 0., 0., 0.).w(), 1.) << "Construction from coefficients should normalize";
+
+  for (const auto &rpy : {llu::Vec3d{0.1, -0.2, 0.3}, llu::Vec3d{-2., 1.2, 3.}, llu::Vec3d{3., -1.5, -0.5}}) {
+    auto expanded = llu::Quatd::fromEulerAngles(rpy);
+    auto product  = llu::Quatd::fromYaw(rpy.z()) * llu::Quatd::fromPitch(rpy.y()) * llu::Quatd::fromRoll(rpy.x());
+    ASSERT_TRUE(expanded.isApprox(product, llu::kEPS)) << "Euler angles to quaternion conversion failed";
+    ASSERT_NEAR(expanded.dot(expanded), 1., llu::kEPS) << "Euler angles should give a unit quaternion";
+  }
+}
@@ -0,0 +1,73 @@
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/histogram.h>
+
+TEST(LLU_HISTOGRAM_TEST, LLU_HISTOGRAM_BUCKET_TEST) {
+  for (std::size_t i{}; i < llu::Histogram::kNumBuckets; ++i) {
+    ASSERT_EQ(llu::Histogram::bucketIndex(llu::Histogram::bucketLowest(i)), i) << "Lowest value of bucket " << i;
+    if (i + 1 < llu::Histogram::kNumBuckets) {
+      ASSERT_EQ(llu::Histogram::bucketIndex(llu::Histogram::bucketHighest(i)), i) << "Highest value of bucket " << i;
+    }
+  }
+  ASSERT_EQ(llu::Histogram::bucketIndex(UINT64_MAX), llu::Histogram::kNumBuckets - 1) << "Large values should clamp";
+  for (std::uint64_t value : {200ULL, 12345ULL, 987654321ULL}) {
+    auto idx = llu::Histogram::bucketIndex(value);
+    auto width = llu::Histogram::bucketHighest(idx) - llu::Histogram::bucketLowest(idx) + 1;
+    ASSERT_LE(width * 64, value) << "Bucket of " << value << " should be within 1/64 of the value";
+  }
+}
+
+TEST(LLU_HISTOGRAM_TEST, LLU_HISTOGRAM_PERCENTILE_TEST) {
+  llu::Histogram hist;
+  ASSERT_EQ(hist.percentile(99.), 0) << "Percentile of an empty histogram should be 0";
+  for (std::uint64_t i{1}; i <= 100000; ++i) hist.record(i);
+  ASSERT_EQ(hist.count(), 100000) << "Count should be 100000";
+  ASSERT_EQ(hist.min(), 1) << "Min should be 1";
+  ASSERT_EQ(hist.max(), 100000) << "Max should be 100000";
+  ASSERT_NEAR(hist.mean(), 50000.5, 1e-6) << "Mean should be exact";
+  for (double p : {50., 90., 99., 99.9}) {
+    double expected = p * 1000.;
+    ASSERT_NEAR(hist.percentile(p), expected, expected / 64.) << "Percentile " << p;
+  }
+  ASSERT_EQ(hist.percentile(0.), 1) << "Percentile 0 should be the min";
+  ASSERT_EQ(hist.percentile(100.), 100000) << "Percentile 100 should be the max";
+
+  hist.record(std::chrono::microseconds(5));
+  ASSERT_EQ(hist.max(), 100000) << "5us should be recorded as 5000ns";
+  ASSERT_EQ(hist.percentile<std::chrono::microseconds>(100.).count(), 100) << "Percentile in microseconds";
+}
+
+TEST(LLU_HISTOGRAM_TEST, LLU_HISTOGRAM_MERGE_TEST) {
+  constexpr int kThreads = 4;
+  std::vector<llu::Histogram> hists(kThreads);
+  std::vector<std::thread> threads;
+  for (int t{}; t < kThreads; ++t) {
+    threads.emplace_back([&hists, t] {
+      std::mt19937_64 gen(t);
+      std::exponential_distribution<double> dist(1e-4);
+      for (int i{}; i < 10000; ++i) hists[t].record(static_cast<std::uint64_t>(dist(gen)));
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  llu::Histogram total, reference;
+  for (auto &hist : hists) total.merge(hist);
+  ASSERT_EQ(total.count(), 40000) << "Merged count should be 40000";
+  for (int t{}; t < kThreads; ++t) {
+    std::mt19937_64 gen(t);
+    std::exponential_distribution<double> dist(1e-4);
+    for (int i{}; i < 10000; ++i) reference.record(static_cast<std::uint64_t>(dist(gen)));
+  }
+  for (double p : {50., 99., 99.9}) ASSERT_EQ(total.percentile(p), reference.percentile(p)) << "Percentile " << p;
+
+  llu::Histogram report;
+  report.swap(total);
+  total.reset();
+  ASSERT_EQ(total.count(), 0) << "Swapped-out histogram should be empty";
+  ASSERT_EQ(report.count(), 40000) << "Report should hold the previous period";
+  ASSERT_EQ(report.max(), reference.max()) << "Report max should match";
+}
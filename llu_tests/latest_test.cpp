@@ -0,0 +1,105 @@
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <llu/eigen.h>
+#include <llu/geometry.h>
+#include <llu/latest.h>
+
+namespace {
+struct State {
+  double values[8];
+};
+
+struct Pose {
+  llu::Quatf rotation;
+  llu::Vec3f position;
+};
+
+State makeState(int i) {
+  State state{};
+  for (auto &value : state.values) value = i;
+  return state;
+}
+}  // namespace
+
+TEST(LLU_LATEST_TEST, LLU_TRIPLE_BUFFER_TEST) {
+  llu::TripleBuffer<llu::VecXf> buffer(llu::VecXf::Zero(3));
+  ASSERT_FALSE(buffer.update()) << "Nothing should be published yet";
+  ASSERT_TRUE(buffer.read().isZero()) << "Initial value should be zero";
+  buffer.write(llu::VecXf::Ones(3));
+  buffer.back() = llu::VecXf::Constant(3, 2.f);
+  buffer.publish();
+  ASSERT_TRUE(buffer.read().isApprox(llu::VecXf::Constant(3, 2.f))) << "Reader should get the newest value";
+  ASSERT_FALSE(buffer.update()) << "Nothing new should be published";
+  ASSERT_TRUE(buffer.read().isApprox(llu::VecXf::Constant(3, 2.f))) << "Reader should keep the newest value";
+
+  llu::TripleBuffer<State> states;
+  std::atomic<bool> done{false};
+  std::thread writer([&states, &done] {
+    for (int i{1}; i <= 100000; ++i) states.write(makeState(i));
+    done = true;
+  });
+  double last = 0.;
+  while (not done or states.update()) {
+    const State &state = states.read();
+    for (double value : state.values) ASSERT_EQ(value, state.values[0]) << "Snapshot should be consistent";
+    ASSERT_GE(state.values[0], last) << "Values should not go back in time";
+    last = state.values[0];
+  }
+  writer.join();
+  ASSERT_EQ(states.read().values[0], 100000.) << "Reader should end with the last value";
+}
+
+TEST(LLU_LATEST_TEST, LLU_LATEST_VALUE_TEST) {
+  llu::LatestValue<State> latest(makeState(0));
+  ASSERT_EQ(latest.version(), 0) << "Version should be 0";
+  latest.store(makeState(1));
+  ASSERT_EQ(latest.version(), 1) << "Version should be 1";
+  State state{};
+  ASSERT_TRUE(latest.try_load(state)) << "Load should succeed without a concurrent writer";
+  ASSERT_EQ(state.values[7], 1.) << "Loaded value should be the stored one";
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i{}; i < 3; ++i) {
+    readers.emplace_back([&latest, &done] {
+      double last = 0.;
+      while (not done) {
+        State state = latest.load();
+        for (double value : state.values) ASSERT_EQ(value, state.values[0]) << "Snapshot should be consistent";
+        ASSERT_GE(state.values[0], last) << "Values should not go back in time";
+        last = state.values[0];
+      }
+    });
+  }
+  for (int i{2}; i <= 100000; ++i) latest.store(makeState(i));
+  done = true;
+  for (auto &reader : readers) reader.join();
+  ASSERT_EQ(latest.load().values[0], 100000.) << "Reader should end with the last value";
+}
+
+TEST(LLU_LATEST_TEST, LLU_LATEST_POSE_TEST) {
+  // Eigen types are not trivially copyable, but hold their state inline
+  llu::LatestValue<Pose> latest({llu::Quatf(), llu::Vec3f::Zero()});
+  std::atomic<bool> done{false};
+  std::thread reader([&latest, &done] {
+    float last = 0.f;
+    while (not done) {
+      Pose pose = latest.load();
+      ASSERT_TRUE((pose.position.array() == pose.position.x()).all()) << "Snapshot should be consistent";
+      ASSERT_NEAR(pose.rotation.z(), std::sin(pose.position.x() * 1e-5f), 1e-6f) << "Snapshot should be consistent";
+      ASSERT_GE(pose.position.x(), last) << "Values should not go back in time";
+      last = pose.position.x();
+    }
+  });
+  for (int i{1}; i <= 100000; ++i) {
+    auto value = static_cast<float>(i);
+    latest.store({llu::Quatf::fromYaw(2 * value * 1e-5f), llu::Vec3f::Constant(value)});
+  }
+  done = true;
+  reader.join();
+  ASSERT_EQ(latest.load().position.z(), 100000.f) << "Reader should end with the last value";
+}
@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+
+#include <llu/eigen.h>
+#include <llu/math.h>
+
+// Built with -ffast-math, which folds the rounding of the branchless kernels away unless they fall back to libm
+TEST(LLU_MATH_FAST_TEST, LLU_MATH_FAST_BATCH_TEST) {
+  ASSERT_TRUE(__FAST_MATH__) << "This test should be built with -ffast-math";
+  llu::ArrXd angles  = llu::ArrXd::LinSpaced(1001, -20., 20.);
+  llu::ArrXd wrapped = llu::batch::wrapToPi(angles);
+  llu::ArrXd diffs   = llu::batch::angleDiff(angles, llu::ArrXd::Constant(angles.size(), 1.));
+  for (Eigen::Index i{}; i < angles.size(); ++i) {
+    ASSERT_NEAR(std::sin(wrapped[i]), std::sin(angles[i]), 1e-9) << "Wrapping should not change the angle";
+    ASSERT_NEAR(std::cos(wrapped[i]), std::cos(angles[i]), 1e-9) << "Wrapping should not change the angle";
+    ASSERT_NEAR(std::abs(diffs[i]), std::abs(llu::angleDiff(angles[i], 1.)), 1e-9)
+        << "Batch angleDiff should agree with the scalar one";
+  }
+
+  llu::ArrXd x = llu::ArrXd::LinSpaced(10001, -100., 100.);
+  ASSERT_LT((llu::batch::approxSin(x) - x.sin()).abs().maxCoeff(), 1e-8) << "Sine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxCos(x) - x.cos()).abs().maxCoeff(), 1e-8) << "Cosine approximation is inaccurate";
+  // Reassociation breaks the exact argument reduction of single precision
+  llu::ArrXf xf = x.cast<float>();
+  ASSERT_LT((llu::batch::approxSin(xf).cast<double>() - xf.cast<double>().sin()).abs().maxCoeff(), 1e-5)
+      << "Sine approximation is inaccurate";
+}
@@ -69,3 +69,63 @@ TEST(LLU_MATH_TEST, LLU_MATH_TEST) {
   ASSERT_NEAR(llu::angleDiff(0., -M_PI*2), 0., llu::kEPS) << "AngleDiff(0, -PI*2) should be 0";
   ASSERT_NEAR(llu::angleDiff(0., M_PI*2), 0., llu::kEPS) << "AngleDiff(0, PI*2) should be 0";
 }
+
+TEST(LLU_MATH_TEST, LLU_MATH_EIGEN_LERP_TEST) {
+  llu::Vec3d start{0., 1., 2.}, end{2., 3., 4.};
+  ASSERT_TRUE(llu::lerp(start, end, 0.5).isApprox(llu::Vec3d{1., 2., 3.})) << "Lerp of vectors failed";
+  ASSERT_TRUE(llu::lerp(start, end, 2.).isApprox(end)) << "Lerp factor should be clamped";
+  llu::ArrXf arr_start = llu::ArrXf::Zero(2), arr_end = llu::ArrXf::Ones(2);
+  ASSERT_TRUE(llu::lerp(arr_start, arr_end, 0.25f).isApprox(llu::ArrXf::Constant(2, 0.25f))) << "Lerp of arrays failed";
+}
+
+TEST(LLU_MATH_TEST, LLU_MATH_BATCH_ANGLE_TEST) {
+  llu::ArrXd angles = llu::ArrXd::LinSpaced(1001, -20., 20.);
+  llu::ArrXd wrapped = llu::batch::wrapToPi(angles);
+  llu::ArrXd diffs   = llu::batch::angleDiff(angles, llu::ArrXd::Constant(angles.size(), 1.));
+  for (Eigen::Index i{}; i < angles.size(); ++i) {
+    ASSERT_GE(wrapped[i], -M_PI) << "Wrapped angle should not be less than -PI";
+    ASSERT_LE(wrapped[i], M_PI) << "Wrapped angle should not be greater than PI";
+    ASSERT_NEAR(std::sin(wrapped[i]), std::sin(angles[i]), 1e-9) << "Wrapping should not change the angle";
+    ASSERT_NEAR(std::cos(wrapped[i]), std::cos(angles[i]), 1e-9) << "Wrapping should not change the angle";
+    ASSERT_NEAR(std::abs(diffs[i]), std::abs(llu::angleDiff(angles[i], 1.)), 1e-9)
+        << "Batch angleDiff should agree with the scalar one";
+  }
+  llu::ArrXf turns_f = llu::ArrXf::LinSpaced(9, -4.f, 4.f) * 2.f * M_PIf + 0.5f;
+  ASSERT_TRUE((llu::batch::wrapToPi(turns_f) - 0.5f).abs().maxCoeff() < 1e-5f) << "Wrapping of full turns failed";
+}
+
+TEST(LLU_MATH_TEST, LLU_MATH_BATCH_TRIG_TEST) {
+  llu::ArrXd x = llu::ArrXd::LinSpaced(10001, -100., 100.);
+  llu::ArrXd u = llu::ArrXd::LinSpaced(10001, -1., 1.);
+  llu::ArrXd y = llu::ArrXd::LinSpaced(10001, -3., 3.).sin() * 5.;
+  llu::ArrXd xs = x / 20.;
+  llu::ArrXd atan2 = y.binaryExpr(xs, [](double a, double b) { return std::atan2(a, b); });
+  ASSERT_LT((llu::batch::approxSin(x) - x.sin()).abs().maxCoeff(), 1e-8) << "Sine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxCos(x) - x.cos()).abs().maxCoeff(), 1e-8) << "Cosine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxAsin(u) - u.asin()).abs().maxCoeff(), 1e-8) << "Arcsine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxAtan2(y, xs) - atan2).abs().maxCoeff(), 1e-8)
+      << "Arctangent approximation is inaccurate";
+
+  // Against the inputs rounded to single precision
+  llu::ArrXf xf = x.cast<float>(), uf = u.cast<float>(), yf = y.cast<float>(), xsf = xs.cast<float>();
+  x     = xf.cast<double>();
+  u     = uf.cast<double>();
+  atan2 = yf.cast<double>().binaryExpr(xsf.cast<double>(), [](double a, double b) { return std::atan2(a, b); });
+  ASSERT_LT((llu::batch::approxSin(xf).cast<double>() - x.sin()).abs().maxCoeff(), 2e-7)
+      << "Sine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxCos(xf).cast<double>() - x.cos()).abs().maxCoeff(), 2e-7)
+      << "Cosine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxAsin(uf).cast<double>() - u.asin()).abs().maxCoeff(), 4e-7)
+      << "Arcsine approximation is inaccurate";
+  ASSERT_LT((llu::batch::approxAtan2(yf, xsf).cast<double>() - atan2).abs().maxCoeff(), 4e-7)
+      << "Arctangent approximation is inaccurate";
+
+  llu::ArrXd axes = llu::ArrXd::Zero(3), signs(3);
+  signs << 1., -1., 0.;
+  ASSERT_NEAR(llu::batch::approxAtan2(axes, signs)[0], 0., llu::kEPS) << "atan2(0, 1) should be 0";
+  ASSERT_NEAR(llu::batch::approxAtan2(axes, signs)[1], M_PI, llu::kEPS) << "atan2(0, -1) should be PI";
+  ASSERT_NEAR(llu::batch::approxAtan2(axes, signs)[2], 0., llu::kEPS) << "atan2(0, 0) should be 0";
+  ASSERT_NEAR(llu::batch::approxAtan2(signs, axes)[0], M_PI / 2, llu::kEPS) << "atan2(1, 0) should be PI/2";
+  ASSERT_NEAR(llu::batch::approxAtan2(signs, axes)[1], -M_PI / 2, llu::kEPS) << "atan2(-1, 0) should be -PI/2";
+  ASSERT_NEAR(llu::batch::approxAtan2(-axes, signs)[1], -M_PI, llu::kEPS) << "atan2(-0, -1) should be -PI";
+}
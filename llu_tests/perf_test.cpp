@@ -0,0 +1,61 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <llu/chrono.h>
+#include <llu/perf.h>
+
+namespace {
+double work(int num) {
+  double sum = 0.;
+  for (int i{}; i < num; ++i) sum += std::sqrt(static_cast<double>(i));
+  return sum;
+}
+}  // namespace
+
+TEST(LLU_PERF_TEST, LLU_PERF_COUNTERS_TEST) {
+  llu::PerfCounters counters;
+  llu::PerfSample before, after;
+  bool ok = counters.read(before);
+  ASSERT_EQ(ok, counters.available()) << "Reading should succeed exactly when counters are available";
+  volatile double sink = work(100000);
+  (void)sink;
+  counters.read(after);
+  if (not counters.available()) {
+    ASSERT_EQ(after.cycles, 0) << "Unavailable counters should read as zero";
+    ASSERT_EQ(after.ipc(), 0.) << "IPC of zero cycles should be zero";
+    GTEST_SKIP() << "Perf events are not available";
+  }
+  auto delta = after - before;
+  ASSERT_GT(delta.cycles, 0) << "Cycles should be counted";
+  if (counters.supported(llu::PerfEvent::kInstructions)) {
+    ASSERT_GT(delta.instructions, 100000) << "Instructions should be counted";
+  }
+}
+
+TEST(LLU_PERF_TEST, LLU_PERF_TIMER_TEST) {
+  llu::PerfCounters counters;
+  llu::PerfStats stats(counters);
+  llu::Timer timer;
+  timer.attach(&stats);
+  for (int i{}; i < 4; ++i) {
+    llu::TimerContext ctx(timer);
+    volatile double sink = work(10000);
+    (void)sink;
+  }
+  ASSERT_EQ(timer.count(), 4) << "Every scope should be timed";
+  ASSERT_EQ(stats.count(), 4) << "Every scope should be sampled";
+  auto total = stats.total();
+  auto mean  = stats.mean();
+  ASSERT_EQ(mean.cycles, total.cycles / 4) << "Mean should divide the total by the count";
+  if (counters.available()) {
+    ASSERT_GT(total.cycles, 0) << "Timer should accumulate cycles";
+  } else {
+    ASSERT_EQ(total.cycles, 0) << "Timer should accumulate nothing without counters";
+  }
+  stats.clear();
+  ASSERT_EQ(stats.total().cycles, 0) << "Clear should reset the counters";
+  timer.attach(nullptr);
+  { llu::TimerContext ctx(timer); }
+  ASSERT_EQ(stats.count(), 0) << "A detached probe should not be sampled";
+}
@@ -0,0 +1,52 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/profiler.h>
+
+namespace {
+void estimate() {
+  LLU_PROFILE("control/estimator/ekf");
+  std::this_thread::sleep_for(llu::USec(500));
+}
+
+void control() {
+  LLU_PROFILE("control");
+  std::this_thread::sleep_for(llu::USec(500));
+  for (int i{}; i < 2; ++i) estimate();
+}
+}  // namespace
+
+TEST(LLU_PROFILER_TEST, LLU_PROFILER_TREE_TEST) {
+  auto &profiler = llu::Profiler::instance();
+  std::vector<std::thread> threads;
+  for (int i{}; i < 2; ++i) {
+    threads.emplace_back([] {
+      for (int j{}; j < 3; ++j) control();
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  auto root = profiler.stats("control");
+  auto ekf  = profiler.stats("control/estimator/ekf");
+  ASSERT_EQ(root.count, 6) << "Root should be entered 6 times across threads";
+  ASSERT_EQ(ekf.count, 12) << "Leaf should be entered 12 times across threads";
+  ASSERT_EQ(profiler.stats("control/estimator").count, 0) << "Intermediate node should only be registered";
+  ASSERT_GE(ekf.mean(), llu::USec(500)) << "Leaf mean should cover its sleep";
+  ASSERT_EQ(ekf.self, ekf.total) << "Leaf self-time should equal its total";
+  ASSERT_GE(root.total, root.self + ekf.total - llu::USec(1)) << "Root self-time should exclude the nested scopes";
+  ASSERT_GE(root.self, llu::MSec(3)) << "Root self-time should cover its own sleeps";
+
+  std::string report = profiler.report();
+  ASSERT_NE(report.find("\ncontrol "), std::string::npos) << report;
+  ASSERT_NE(report.find("\n  estimator "), std::string::npos) << report;
+  ASSERT_NE(report.find("\n    ekf "), std::string::npos) << report;
+
+  profiler.reset();
+  ASSERT_EQ(profiler.stats("control").count, 0) << "Reset should clear all counters";
+  try {
+    (void)profiler.stats("unknown");
+    ASSERT_TRUE(false) << "Unknown node should throw";
+  } catch (std::runtime_error &e) {}
+}
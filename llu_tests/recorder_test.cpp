@@ -0,0 +1,71 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <llu/recorder.h>
+
+namespace {
+struct Record {
+  double time;
+  float joint_pos[12];
+};
+
+std::string tempPath() { return testing::TempDir() + "llu_recorder_test.bin"; }
+}  // namespace
+
+TEST(LLU_RECORDER_TEST, LLU_RECORDER_DATA_TEST) {
+  std::string path = tempPath();
+  {
+    llu::FlightRecorder<Record> recorder(path, 4);
+    ASSERT_EQ(recorder.capacity(), 4) << "Capacity should be 4";
+    ASSERT_TRUE(llu::FlightRecorder<Record>::recover(path).empty()) << "Nothing should be recovered yet";
+    for (int i{}; i < 3; ++i) recorder.push_back(Record{static_cast<double>(i), {}});
+    auto records = llu::FlightRecorder<Record>::recover(path);
+    ASSERT_EQ(records.size(), 3) << "Three records should be recovered";
+    ASSERT_EQ(records.front().time, 0.) << "Records should be ordered from oldest to newest";
+    for (int i{3}; i < 10; ++i) recorder.push_back(Record{static_cast<double>(i), {}});
+    ASSERT_EQ(recorder.written(), 10) << "Ten records should be written";
+    recorder.sync();
+  }
+  auto records = llu::FlightRecorder<Record>::recover(path);
+  ASSERT_EQ(records.size(), 4) << "The latest four records should be recovered";
+  for (int i{}; i < 4; ++i) ASSERT_EQ(records[i].time, 6. + i) << "Recovered records mismatch";
+  records = llu::FlightRecorder<Record>::recover(path, 2);
+  ASSERT_EQ(records.size(), 2) << "Two records should be recovered";
+  ASSERT_EQ(records.back().time, 9.) << "Recovered records mismatch";
+
+  ASSERT_THROW(llu::FlightRecorder<double>::recover(path), std::runtime_error) << "Record size should be checked";
+
+  // A new recorder keeps the file of the previous run
+  {
+    llu::FlightRecorder<Record> recorder(path, 4);
+    ASSERT_TRUE(llu::FlightRecorder<Record>::recover(path).empty()) << "New recorder should start empty";
+    records = llu::FlightRecorder<Record>::recover(path + ".prev");
+    ASSERT_EQ(records.size(), 4) << "Previous records should be kept";
+    ASSERT_EQ(records.back().time, 9.) << "Previous records mismatch";
+  }
+  std::remove(path.c_str());
+  std::remove((path + ".prev").c_str());
+  ASSERT_THROW(llu::FlightRecorder<Record>::recover(path), std::runtime_error) << "Missing file should throw";
+}
+
+TEST(LLU_RECORDER_TEST, LLU_RECORDER_CRASH_TEST) {
+  std::string path = tempPath();
+  pid_t pid        = fork();
+  ASSERT_GE(pid, 0) << "Fork failed";
+  if (pid == 0) {
+    llu::FlightRecorder<Record> recorder(path, 8);
+    for (int i{}; i < 100; ++i) recorder.push_back(Record{static_cast<double>(i), {}});
+    _exit(1);  // exits without unmapping or flushing anything
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  auto records = llu::FlightRecorder<Record>::recover(path);
+  ASSERT_EQ(records.size(), 8) << "The latest records should survive the crash";
+  ASSERT_EQ(records.back().time, 99.) << "Recovered records mismatch";
+  std::remove(path.c_str());
+}
@@ -0,0 +1,68 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <llu/spsc.h>
+
+TEST(LLU_SPSC_TEST, LLU_SPSC_DATA_TEST) {
+  llu::SpscQueue<int> q(3);
+  ASSERT_EQ(q.capacity(), 4) << "Capacity should be rounded up to 4";
+  ASSERT_TRUE(q.is_empty()) << "Queue should be empty";
+  int item = -1;
+  ASSERT_FALSE(q.try_pop(item)) << "Pop should fail on an empty queue";
+  ASSERT_FALSE(q.peek(item)) << "Peek should fail on an empty queue";
+
+  for (int i{}; i < 4; ++i) ASSERT_TRUE(q.try_push(i)) << "Push should succeed";
+  ASSERT_TRUE(q.is_full()) << "Queue should be full";
+  ASSERT_FALSE(q.try_push(4)) << "Push should fail on a full queue";
+  ASSERT_TRUE(q.peek(item));
+  ASSERT_EQ(item, 0) << "Peek should be 0";
+  for (int i{}; i < 4; ++i) {
+    ASSERT_TRUE(q.try_pop(item)) << "Pop should succeed";
+    ASSERT_EQ(item, i) << "Items should be popped in order";
+  }
+  ASSERT_TRUE(q.is_empty()) << "Queue should be empty";
+}
+
+TEST(LLU_SPSC_TEST, LLU_SPSC_OVERWRITE_TEST) {
+  llu::SpscQueue<int, true> q(4);
+  for (int i{}; i < 6; ++i) q.push_back(i);
+  ASSERT_EQ(q.size(), 4) << "Size should be 4";
+  int item = -1;
+  for (int i{2}; i < 6; ++i) {
+    ASSERT_TRUE(q.try_pop(item)) << "Pop should succeed";
+    ASSERT_EQ(item, i) << "Oldest items should have been dropped";
+  }
+  ASSERT_FALSE(q.try_pop(item)) << "Pop should fail on an empty queue";
+}
+
+TEST(LLU_SPSC_TEST, LLU_SPSC_THREAD_TEST) {
+  constexpr int kNum = 100000;
+  llu::SpscQueue<int> q(64);
+  std::thread producer([&q] {
+    for (int i{}; i < kNum; ++i) {
+      while (not q.try_push(i)) std::this_thread::yield();
+    }
+  });
+  int item = -1;
+  for (int i{}; i < kNum; ++i) {
+    while (not q.try_pop(item)) std::this_thread::yield();
+    ASSERT_EQ(item, i) << "Items should be received in order";
+  }
+  producer.join();
+
+  llu::SpscQueue<int, true> q2(16);
+  std::thread overwriter([&q2] {
+    for (int i{}; i < kNum; ++i) q2.push_back(i);
+  });
+  int last = -1;
+  while (last < kNum - 1) {
+    if (not q2.try_pop(item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_GT(item, last) << "Items should be received in increasing order";
+    last = item;
+  }
+  overwriter.join();
+}
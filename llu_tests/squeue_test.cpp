@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <llu/squeue.h>
@@ -92,3 +97,134 @@ TEST(LLU_SQUEUE_TEST, LLU_SQUEUE_DATA_TEST) {
   ASSERT_EQ(q.get_padded(-4), 2) << "GetPadded(-4) should be 2";
   ASSERT_EQ(q.get_padded(-5), 2) << "GetPadded(-5) should be 2";
 }
+
+TEST(LLU_SQUEUE_TEST, LLU_SQUEUE_STORAGE_TEST) {
+  llu::StaticQueue<std::string> q(2);
+  q.push_back("first");
+  q.emplace_back(3, 'x');
+  q.push_back(q.front());
+  ASSERT_EQ(q.front(), "xxx") << "Front should be xxx";
+  ASSERT_EQ(q.back(), "first") << "Back should be first";
+  q.emplace_back("last");
+  ASSERT_EQ(q.front(), "first") << "Front should be first";
+
+  llu::StaticQueue<std::string> copy(q);
+  q.clear();
+  ASSERT_EQ(copy.size(), 2) << "Copied queue should keep its items";
+  ASSERT_EQ(copy.back(), "last") << "Copied back should be last";
+  copy.allocate(1);
+  ASSERT_EQ(copy.size(), 1) << "Shrinking should keep the newest item";
+  ASSERT_EQ(copy.front(), "last") << "Shrinking should keep the newest item";
+  copy.allocate(4);
+  ASSERT_EQ(copy.capacity(), 4) << "Capacity should be 4";
+  ASSERT_EQ(copy.front(), "last") << "Growing should keep the items";
+  copy.pop_front();
+  ASSERT_TRUE(copy.is_empty()) << "Queue should be empty after popping";
+  try {
+    copy.pop_front();
+    ASSERT_TRUE(false) << "EmptyQueue exception should be thrown";
+  } catch (llu::StaticQueue<std::string>::EmptyQueue &e) {}
+
+  llu::StaticQueue<std::string> full(1);
+  full.push_back("overwritten");
+  full.emplace_back(full.front(), 4, 3);
+  ASSERT_EQ(full.front(), "wri") << "Arguments should be read before the overwritten item is replaced";
+
+  llu::StaticQueue<int, true> pow2(5);
+  ASSERT_EQ(pow2.capacity(), 8) << "Capacity should be rounded up to 8";
+  for (int i{}; i < 10; ++i) pow2.push_back(i);
+  ASSERT_EQ(pow2.front(), 2) << "Front should be 2";
+  ASSERT_EQ(pow2.at(-1), 9) << "At(-1) should be 9";
+}
+
+TEST(LLU_SQUEUE_TEST, LLU_SQUEUE_ITERATOR_TEST) {
+  llu::StaticQueue<int> q(5);
+  for (int i{}; i < 8; ++i) q.push_back(i);
+  auto [first, second] = q.segments();
+  ASSERT_EQ(first.size, 2) << "First segment should hold 2 items";
+  ASSERT_EQ(second.size, 3) << "Second segment should hold 3 items";
+  ASSERT_EQ(*first.begin(), 3) << "First segment should start with the oldest item";
+  ASSERT_EQ(*(second.end() - 1), 7) << "Second segment should end with the newest item";
+
+  ASSERT_EQ(q.end() - q.begin(), 5) << "Iterator distance should be the size";
+  ASSERT_EQ(q.begin()[2], 5) << "Iterator subscript should follow the queue order";
+  ASSERT_EQ(*std::max_element(q.begin(), q.end()), 7) << "Max element should be 7";
+  ASSERT_EQ(std::accumulate(q.begin(), q.end(), 0), 25) << "Sum should be 25";
+  ASSERT_TRUE(std::is_sorted(q.begin(), q.end())) << "Items should be sorted";
+  std::reverse(q.begin(), q.end());
+  ASSERT_EQ(q.front(), 7) << "Front should be 7 after reversing";
+  std::sort(q.begin(), q.end());
+  ASSERT_EQ(q.front(), 3) << "Front should be 3 after sorting";
+
+  const auto &cq = q;
+  llu::StaticQueue<int>::const_iterator it = q.begin();
+  ASSERT_EQ(*it, *cq.begin()) << "Iterator should convert to const_iterator";
+  ASSERT_EQ(cq.end() - it, 5) << "Iterator distance should be the size";
+}
+
+TEST(LLU_SQUEUE_TEST, LLU_SQUEUE_BULK_TEST) {
+  std::vector<int> data(10);
+  std::iota(data.begin(), data.end(), 0);
+  llu::StaticQueue<int> q(4);
+  q.push_back(-1);
+  q.push_range(data.data(), data.data() + 2);
+  ASSERT_EQ(q.size(), 3) << "Size should be 3";
+  q.push_range(data.data() + 2, data.data() + 5);
+  ASSERT_EQ(q.size(), 4) << "Size should be 4";
+  std::vector<int> out(4);
+  q.copy_out(out.data());
+  ASSERT_EQ(out, (std::vector<int>{1, 2, 3, 4})) << "Copied items should be 1, 2, 3, 4";
+  q.push_range(data.begin(), data.end());
+  q.copy_out(out.begin());
+  ASSERT_EQ(out, (std::vector<int>{6, 7, 8, 9})) << "Copied items should be 6, 7, 8, 9";
+  q.push_range(data.data(), data.data() + 10);
+  q.copy_out(out.data());
+  ASSERT_EQ(out, (std::vector<int>{6, 7, 8, 9})) << "Copied items should be 6, 7, 8, 9";
+
+  llu::StaticQueue<std::string> sq(2);
+  std::vector<std::string> strings{"a", "b", "c"};
+  sq.push_range(strings.begin(), strings.end());
+  std::vector<std::string> string_out;
+  sq.copy_out(std::back_inserter(string_out));
+  ASSERT_EQ(string_out, (std::vector<std::string>{"b", "c"})) << "Copied items should be b, c";
+}
+
+namespace {
+constexpr int fixedQueueSum() {
+  llu::FixedQueue<int, 3> q;
+  for (int i{}; i < 5; ++i) q.push_back(i);
+  int sum = 0;
+  for (int item : q) sum += item;
+  return sum;
+}
+}  // namespace
+
+TEST(LLU_SQUEUE_TEST, LLU_FIXED_QUEUE_TEST) {
+  static_assert(fixedQueueSum() == 9, "FixedQueue should be usable in constant expressions");
+  static_assert(llu::FixedQueue<int, 5>::capacity() == 5, "Capacity should be 5");
+
+  llu::FixedQueue<int, 3> q;
+  try {
+    auto front = q.front();
+    ASSERT_TRUE(false) << "EmptyQueue exception should be thrown";
+  } catch (llu::StaticQueue<int>::EmptyQueue &e) {}
+  for (int i{}; i < 5; ++i) q.emplace_back(i);
+  ASSERT_TRUE(q.is_full()) << "Queue should be full";
+  ASSERT_EQ(q.front(), 2) << "Front should be 2";
+  ASSERT_EQ(q.back(), 4) << "Back should be 4";
+  ASSERT_EQ(q.at(-2), 3) << "At(-2) should be 3";
+  ASSERT_EQ(q.get(3, -1), -1) << "Get(3, -1) should be -1";
+  ASSERT_EQ(q.get_padded(-5), 2) << "GetPadded(-5) should be 2";
+  ASSERT_EQ(*std::max_element(q.begin(), q.end()), 4) << "Max element should be 4";
+  try {
+    auto item = q.at(3);
+    ASSERT_TRUE(false) << "IndexOutOfRange exception should be thrown";
+  } catch (llu::StaticQueue<int>::IndexOutOfRange &e) {}
+  q.clear();
+  ASSERT_TRUE(q.is_empty()) << "Queue should be empty";
+
+  llu::FixedQueue<std::string, 4> sq;
+  for (int i{}; i < 6; ++i) sq.push_back(std::to_string(i));
+  ASSERT_EQ(sq.front(), "2") << "Front should be 2";
+  ASSERT_EQ(sq.back(), "5") << "Back should be 5";
+}
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/stats.h>
+
+namespace {
+template <typename T>
+void testWindow(const llu::WindowStats<T> &stats, std::vector<T> window) {
+  double mean = std::accumulate(window.begin(), window.end(), 0.) / window.size();
+  double var  = 0.;
+  for (T item : window) var += (item - mean) * (item - mean);
+  var /= window.size();
+  std::sort(window.begin(), window.end());
+  ASSERT_NEAR(stats.mean(), mean, 1e-6) << "Windowed mean mismatch";
+  ASSERT_NEAR(stats.var(), var, 1e-6) << "Windowed variance mismatch";
+  ASSERT_EQ(stats.min(), window.front()) << "Windowed min mismatch";
+  ASSERT_EQ(stats.max(), window.back()) << "Windowed max mismatch";
+  std::size_t mid = window.size() / 2;
+  T median        = window.size() % 2 ? window[mid] : (window[mid - 1] + window[mid]) / 2;
+  ASSERT_NEAR(stats.median(), median, 1e-9) << "Windowed median mismatch";
+  ASSERT_EQ(stats.quantile(0.), window.front()) << "Windowed quantile(0) mismatch";
+  ASSERT_EQ(stats.quantile(1.), window.back()) << "Windowed quantile(1) mismatch";
+}
+}  // namespace
+
+TEST(LLU_STATS_TEST, LLU_WINDOW_STATS_TEST) {
+  llu::WindowStats<double> stats(5);
+  ASSERT_TRUE(stats.is_empty()) << "Stats should be empty";
+  ASSERT_EQ(stats.min(), 0.) << "Min of an empty window should be 0";
+  ASSERT_EQ(stats.max(), 0.) << "Max of an empty window should be 0";
+  ASSERT_EQ(llu::WindowStats<double>().min(), 0.) << "Min of an unallocated window should be 0";
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-10., 10.);
+  std::vector<double> samples;
+  for (int i{}; i < 200; ++i) {
+    samples.push_back(i % 7 == 0 ? 1. : dist(gen));
+    stats.push_back(samples.back());
+    std::size_t begin = samples.size() > 5 ? samples.size() - 5 : 0;
+    testWindow(stats, std::vector<double>(samples.begin() + begin, samples.end()));
+  }
+  ASSERT_EQ(stats.size(), 5) << "Window size should be 5";
+  ASSERT_EQ(stats.window().back(), samples.back()) << "Window should follow the samples";
+  stats.clear();
+  ASSERT_TRUE(stats.is_empty()) << "Stats should be empty";
+  stats.push_back(2.);
+  testWindow(stats, {2.});
+  ASSERT_THROW(stats.push_back(std::numeric_limits<double>::quiet_NaN()), std::runtime_error)
+      << "NaN samples should be rejected";
+  ASSERT_THROW(stats.push_back(std::numeric_limits<double>::infinity()), std::runtime_error)
+      << "Infinite samples should be rejected";
+  testWindow(stats, {2.});
+}
+
+TEST(LLU_STATS_TEST, LLU_WINDOW_STATS_ARRAY_TEST) {
+  llu::WindowStats<llu::ArrXf> stats(2, 3);
+  ASSERT_EQ(stats.dim(), 2) << "Dim should be 2";
+  for (int i{}; i < 5; ++i) stats.push_back(llu::Arr2f{static_cast<float>(i), static_cast<float>(-i)});
+  ASSERT_EQ(stats.size(), 3) << "Window size should be 3";
+  ASSERT_TRUE(stats.mean().isApprox(llu::Arr2f{3.f, -3.f})) << "Element-wise mean mismatch";
+  ASSERT_TRUE(stats.var().isApprox(llu::Arr2f{2.f / 3.f, 2.f / 3.f})) << "Element-wise variance mismatch";
+  ASSERT_TRUE(stats.min().isApprox(llu::Arr2f{2.f, -4.f})) << "Element-wise min mismatch";
+  ASSERT_TRUE(stats.max().isApprox(llu::Arr2f{4.f, -2.f})) << "Element-wise max mismatch";
+  ASSERT_TRUE(stats.median().isApprox(llu::Arr2f{3.f, -3.f})) << "Element-wise median mismatch";
+  ASSERT_THROW(stats.push_back(llu::Arr3f::Zero()), std::runtime_error) << "Samples of another size should be rejected";
+}
@@ -0,0 +1,43 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/sync.h>
+
+TEST(LLU_SYNC_TEST, LLU_SYNC_APPROXIMATE_TEST) {
+  llu::TimePoint t0{};
+  llu::Synchronizer<int, double, std::string> sync(8, llu::MSec(3));
+  std::vector<std::tuple<int, double, std::string>> matches;
+  sync.setCallback([&matches](const llu::Stamped<int> &a, const llu::Stamped<double> &b,
+                              const llu::Stamped<std::string> &c) { matches.emplace_back(a.value, b.value, c.value); });
+
+  // Stream 0 at 100 Hz, stream 1 at 200 Hz with an offset, stream 2 at 50 Hz
+  for (int ms{}; ms <= 40; ++ms) {
+    if (ms % 10 == 0) sync.push<0>(t0 + llu::MSec(ms), ms);
+    if (ms % 5 == 1) sync.push<1>(t0 + llu::MSec(ms), static_cast<double>(ms));
+    if (ms % 20 == 2) sync.push<2>(t0 + llu::MSec(ms), std::to_string(ms));
+  }
+  ASSERT_EQ(sync.matched(), 2) << "Two tuples should be matched";
+  ASSERT_EQ(matches.size(), 2) << "Callback should be called twice";
+  ASSERT_EQ(matches[0], std::make_tuple(0, 1., std::string("2"))) << "First match mismatch";
+  ASSERT_EQ(matches[1], std::make_tuple(20, 21., std::string("22"))) << "Second match mismatch";
+  ASSERT_GT(sync.dropped(), 0) << "Unmatched messages should be dropped";
+}
+
+TEST(LLU_SYNC_TEST, LLU_SYNC_EXACT_TEST) {
+  llu::TimePoint t0{};
+  llu::Synchronizer<int, int> sync(4, llu::MSec(3), llu::SyncPolicy::kExact);
+  std::vector<std::pair<int, int>> matches;
+  sync.setCallback([&matches](const llu::Stamped<int> &a, const llu::Stamped<int> &b) {
+    ASSERT_TRUE(a.time == b.time) << "Exact matches should have equal timestamps";
+    matches.emplace_back(a.value, b.value);
+  });
+  sync.push<0>(t0 + llu::MSec(1), 1);
+  sync.push<1>(t0 + llu::MSec(2), 2);
+  sync.push<0>(t0 + llu::MSec(2), 3);
+  sync.push<1>(t0 + llu::MSec(3), 4);
+  sync.push<0>(t0 + llu::MSec(3), 5);
+  ASSERT_EQ(matches, (std::vector<std::pair<int, int>>{{3, 2}, {5, 4}})) << "Exact matches mismatch";
+  ASSERT_EQ(sync.dropped(), 1) << "One message should be dropped";
+}
@@ -0,0 +1,70 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/tqueue.h>
+
+TEST(LLU_TQUEUE_TEST, LLU_TQUEUE_LOOKUP_TEST) {
+  llu::TimePoint t0{};
+  llu::TimedQueue<double> q(4);
+  double value = 0.;
+  ASSERT_FALSE(q.interpolate(t0, value)) << "Interpolation should fail on an empty queue";
+  for (int i{}; i < 6; ++i) q.push_back(t0 + llu::MSec(10 * i), i);
+  ASSERT_EQ(q.size(), 4) << "Size should be 4";
+  ASSERT_EQ(q.front().value, 2.) << "Front should be 2";
+  try {
+    q.push_back(t0, 0.);
+    ASSERT_TRUE(false) << "OutOfOrder exception should be thrown";
+  } catch (llu::TimedQueue<double>::OutOfOrder &e) {}
+
+  ASSERT_EQ(q.lower_bound(t0 + llu::MSec(31))->value, 4.) << "Lower bound of 31ms should be 4";
+  ASSERT_EQ(q.lower_bound(t0)->value, 2.) << "Lower bound of 0ms should be 2";
+  ASSERT_TRUE(q.lower_bound(t0 + llu::MSec(51)) == q.end()) << "Lower bound of 51ms should be the end";
+  ASSERT_EQ(q.nearest(t0 + llu::MSec(34)).value, 3.) << "Nearest of 34ms should be 3";
+  ASSERT_EQ(q.nearest(t0 + llu::MSec(36)).value, 4.) << "Nearest of 36ms should be 4";
+  ASSERT_EQ(q.nearest(t0).value, 2.) << "Nearest of 0ms should be 2";
+  ASSERT_EQ(q.nearest(t0 + llu::MSec(100)).value, 5.) << "Nearest of 100ms should be 5";
+
+  ASSERT_TRUE(q.interpolate(t0 + llu::MSec(25), value)) << "Interpolation should succeed";
+  ASSERT_NEAR(value, 2.5, llu::kEPS) << "Interpolation at 25ms should be 2.5";
+  ASSERT_TRUE(q.interpolate(t0 + llu::MSec(50), value)) << "Interpolation should succeed";
+  ASSERT_NEAR(value, 5., llu::kEPS) << "Interpolation at 50ms should be 5";
+  ASSERT_FALSE(q.interpolate(t0 + llu::MSec(19), value)) << "Interpolation should fail before the front";
+  ASSERT_FALSE(q.interpolate(t0 + llu::MSec(51), value)) << "Interpolation should fail after the back";
+}
+
+TEST(LLU_TQUEUE_TEST, LLU_TQUEUE_INTERPOLATE_TEST) {
+  llu::TimePoint t0{};
+  llu::TimedQueue<llu::Vec3d> vq(2);
+  vq.push_back(t0, llu::Vec3d::Zero());
+  vq.push_back(t0 + llu::MSec(10), llu::Vec3d{1., 2., 3.});
+  llu::Vec3d vec;
+  ASSERT_TRUE(vq.interpolate(t0 + llu::MSec(5), vec)) << "Interpolation should succeed";
+  ASSERT_TRUE(vec.isApprox(llu::Vec3d{0.5, 1., 1.5})) << "Vectors should be interpolated linearly";
+
+  llu::TimedQueue<llu::Quatd> qq(2);
+  qq.push_back(t0, llu::Quatd::fromYaw(0.));
+  qq.push_back(t0 + llu::MSec(10), llu::Quatd::fromYaw(2.));
+  llu::Quatd quat;
+  ASSERT_TRUE(qq.interpolate(t0 + llu::MSec(3), quat)) << "Interpolation should succeed";
+  ASSERT_TRUE(quat.isApprox(llu::Quatd::fromYaw(0.6), 1e-9)) << "Quaternions should be interpolated spherically";
+}
+
+TEST(LLU_TQUEUE_TEST, LLU_TQUEUE_RESAMPLE_TEST) {
+  llu::TimePoint t0{};
+  llu::TimedQueue<double> q(8);
+  std::vector<double> values;
+  auto emit = [&values](llu::TimePoint, double value) { values.push_back(value); };
+  llu::TimePoint next = t0;
+  ASSERT_EQ(q.resample(next, llu::MSec(4), emit), 0) << "Nothing should be emitted without samples";
+
+  q.push_back(t0 + llu::MSec(3), 3.);
+  q.push_back(t0 + llu::MSec(13), 13.);
+  ASSERT_EQ(q.resample(next, llu::MSec(4), emit), 3) << "Grid points 4, 8, 12 should be emitted";
+  ASSERT_TRUE(next == t0 + llu::MSec(16)) << "Next grid point should be 16ms";
+  q.push_back(t0 + llu::MSec(23), 23.);
+  ASSERT_EQ(q.resample(next, llu::MSec(4), emit), 2) << "Grid points 16, 20 should be emitted";
+  ASSERT_EQ(values, (std::vector<double>{4., 8., 12., 16., 20.})) << "Resampled values mismatch";
+  ASSERT_THROW(q.resample(next, llu::Duration::zero(), emit), std::runtime_error) << "Zero period should throw";
+  ASSERT_THROW(q.resample(next, -llu::MSec(4), emit), std::runtime_error) << "Negative period should throw";
+}
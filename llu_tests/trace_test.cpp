@@ -0,0 +1,55 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <llu/trace.h>
+
+namespace {
+std::size_t countOf(const std::string &text, const std::string &pattern) {
+  std::size_t count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) ++count;
+  return count;
+}
+
+void work() {
+  LLU_TRACE_SCOPE("outer");
+  for (int i{}; i < 10; ++i) {
+    LLU_TRACE_SCOPE("inner");
+    std::this_thread::sleep_for(llu::USec(10));
+  }
+}
+}  // namespace
+
+TEST(LLU_TRACE_TEST, LLU_TRACE_FILE_TEST) {
+  std::string path = testing::TempDir() + "llu_trace_test.json";
+  auto &tracer     = llu::Tracer::instance();
+  work();  // not recorded before start
+  tracer.start(path, llu::MSec(5));
+  ASSERT_TRUE(llu::Tracer::enabled()) << "Tracing should be enabled after start";
+  std::vector<std::thread> threads;
+  for (int i{}; i < 3; ++i) threads.emplace_back(work);
+  for (auto &thread : threads) thread.join();
+  llu::Tracer::setEnabled(false);
+  work();  // not recorded while paused
+  llu::Tracer::setEnabled(true);
+  work();
+  { LLU_TRACE_SCOPE("say \"hi\"\\\n"); }
+  tracer.stop();
+  ASSERT_FALSE(llu::Tracer::enabled()) << "Tracing should be disabled after stop";
+
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  std::string text = ss.str();
+  ASSERT_EQ(text.front(), '[') << "Trace should be a JSON array";
+  ASSERT_EQ(text.substr(text.size() - 2), "]\n") << "Trace should be a closed JSON array";
+  ASSERT_EQ(countOf(text, R"("name":"outer")"), 4) << "Four outer scopes should be recorded";
+  ASSERT_EQ(countOf(text, R"("name":"inner")"), 40) << "Forty inner scopes should be recorded";
+  ASSERT_EQ(countOf(text, R"("name":"say \"hi\"\\\u000a")"), 1) << "Event names should be escaped";
+  ASSERT_EQ(countOf(text, R"("ph":"X")"), 45) << "Every scope should be a complete event";
+  ASSERT_EQ(tracer.dropped(), 0) << "No event should be dropped";
+}
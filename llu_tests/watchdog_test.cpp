@@ -0,0 +1,43 @@
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <llu/watchdog.h>
+
+TEST(LLU_WATCHDOG_TEST, LLU_WATCHDOG_MISS_TEST) {
+  llu::Watchdog watchdog(llu::MSec(1));
+  std::atomic<int> fired{0};
+  auto &healthy = watchdog.add("healthy", llu::MSec(20));
+  auto &stalled = watchdog.add("stalled", llu::MSec(5), [&](const llu::Overrun &overrun) {
+    ASSERT_EQ(overrun.loop, 1) << "Overrun should refer to the stalled loop";
+    ++fired;
+  });
+  ASSERT_EQ(stalled.name(), "stalled") << "Heartbeat should keep its name";
+  watchdog.start();
+
+  auto run = [](llu::Heartbeat &heartbeat, llu::Duration duration) {
+    auto start = llu::Clock::now();
+    while (llu::Clock::now() - start < duration) {
+      heartbeat.kick();
+      std::this_thread::sleep_for(llu::USec(500));
+    }
+  };
+  std::thread healthy_loop(run, std::ref(healthy), llu::MSec(80));
+  run(stalled, llu::MSec(10));
+  std::this_thread::sleep_for(llu::MSec(20));  // stall
+  ASSERT_EQ(fired, 1) << "A stall should be reported once";
+  run(stalled, llu::MSec(10));
+  ASSERT_EQ(fired, 1) << "Kicking again should not report";
+  std::this_thread::sleep_for(llu::MSec(20));  // stall again
+  healthy_loop.join();
+  watchdog.stop();
+
+  ASSERT_EQ(fired, 2) << "The second stall should be reported";
+  ASSERT_EQ(stalled.misses(), 2) << "Two misses should be counted";
+  ASSERT_EQ(healthy.misses(), 0) << "The healthy loop should not miss";
+  auto overruns = watchdog.overruns();
+  ASSERT_EQ(overruns.size(), 2) << "Two overruns should be recorded";
+  ASSERT_GT(overruns[0].stalled, llu::MSec(5)) << "Stall should exceed the deadline";
+  ASSERT_LT(overruns[0].time, overruns[1].time) << "Overruns should be ordered by time";
+}